@@ -1,99 +1,367 @@
 #ifndef GROBNER_ALGORITHM_H_
 #define GROBNER_ALGORITHM_H_
 
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
 #include "monomial.h"
 #include "monomial_order.h"
+#include "pair_filter.h"
 #include "polynomial.h"
+#include "polynomial_basis.h"
 #include "polynomial_set.h"
+#include "sparse_monomial.h"
+#include "statistics.h"
 
 namespace grobner {
 
+// Every method that does real work has an overload taking a monitor (see statistics.h),
+// which is notified about pairs, reductions and phases. Overloads without it use NoStatistics.
+// The main loop also takes a pair filter (see pair_filter.h), NoPairFilter by default, and a
+// reduction policy (FullReduction or TopReduction below), FullReduction by default.
 class Algorithm {
   public:
-    template<class Order, class ValueType>
-    static void extend_to_grobners_basis(PolynomialSet<ValueType>* F);
+    template<class Order, class ValueType, class MonomialType = Monomial>
+    static void extend_to_grobners_basis(PolynomialSet<ValueType, MonomialType>* F);
+    template<class Order, class ValueType, class Monitor, class MonomialType = Monomial>
+    static void extend_to_grobners_basis(PolynomialSet<ValueType, MonomialType>* F, Monitor* monitor);
+    template<class Order, class ValueType, class Monitor, class PairFilter, class MonomialType = Monomial>
+    static void extend_to_grobners_basis(PolynomialSet<ValueType, MonomialType>* F, Monitor* monitor, PairFilter* filter);
+    template<class Order, class ValueType, class Monitor, class PairFilter, class Reduction, class MonomialType = Monomial>
+    static void extend_to_grobners_basis(PolynomialSet<ValueType, MonomialType>* F, Monitor* monitor, PairFilter* filter,
+                                         Reduction* reduction);
+
+    // main loop of extend_to_grobners_basis: F is the current basis, set_of_s is the queue of
+    // S-polynomials that still have to be reduced; used to resume an interrupted computation
+    template<class Order, class ValueType, class Monitor, class MonomialType = Monomial>
+    static void continue_grobners_basis(PolynomialSet<ValueType, MonomialType>* F, PolynomialSet<ValueType, MonomialType>* set_of_s,
+                                        Monitor* monitor);
+    template<class Order, class ValueType, class Monitor, class PairFilter, class MonomialType = Monomial>
+    static void continue_grobners_basis(PolynomialSet<ValueType, MonomialType>* F, PolynomialSet<ValueType, MonomialType>* set_of_s,
+                                        Monitor* monitor, PairFilter* filter);
 
-    template<class Order, class ValueType>
-    static void auto_reduce(PolynomialSet<ValueType>* F);
+    // truncated computation: S-polynomials of total degree greater than max_degree are not
+    // reduced but returned (left in set_of_s), so the computation can be continued later by
+    // continue_grobners_basis or with a larger bound. For homogeneous F and a degree compatible
+    // Order, every element of the ideal of degree at most max_degree reduces to zero by F
+    template<class Order, class ValueType, class MonomialType = Monomial>
+    static PolynomialSet<ValueType, MonomialType> extend_to_grobners_basis_up_to(
+            PolynomialSet<ValueType, MonomialType>* F, typename MonomialType::DegreeType max_degree);
+    template<class Order, class ValueType, class Monitor, class MonomialType = Monomial>
+    static PolynomialSet<ValueType, MonomialType> extend_to_grobners_basis_up_to(
+            PolynomialSet<ValueType, MonomialType>* F, typename MonomialType::DegreeType max_degree, Monitor* monitor);
+    template<class Order, class ValueType, class Monitor, class MonomialType = Monomial>
+    static void continue_grobners_basis_up_to(PolynomialSet<ValueType, MonomialType>* F, PolynomialSet<ValueType, MonomialType>* set_of_s,
+                                              typename MonomialType::DegreeType max_degree, Monitor* monitor);
+    template<class Order, class ValueType, class Monitor, class PairFilter, class MonomialType = Monomial>
+    static void continue_grobners_basis_up_to(PolynomialSet<ValueType, MonomialType>* F, PolynomialSet<ValueType, MonomialType>* set_of_s,
+                                              typename MonomialType::DegreeType max_degree, Monitor* monitor, PairFilter* filter);
+    template<class Order, class ValueType, class Monitor, class PairFilter, class Reduction, class MonomialType = Monomial>
+    static void continue_grobners_basis_up_to(PolynomialSet<ValueType, MonomialType>* F, PolynomialSet<ValueType, MonomialType>* set_of_s,
+                                              typename MonomialType::DegreeType max_degree, Monitor* monitor, PairFilter* filter,
+                                              Reduction* reduction);
 
-    template<class Order, class ValueType>
-    static std::pair<Monomial, ValueType> get_leading_term(const Polynomial<ValueType>& f);
+    template<class Order, class ValueType, class MonomialType = Monomial>
+    static void auto_reduce(PolynomialSet<ValueType, MonomialType>* F);
+    template<class Order, class ValueType, class Monitor, class MonomialType = Monomial>
+    static void auto_reduce(PolynomialSet<ValueType, MonomialType>* F, Monitor* monitor);
+    // with the normalization and the reduction of the policy (see FullReduction)
+    template<class Order, class ValueType, class Monitor, class Reduction, class MonomialType = Monomial>
+    static void auto_reduce(PolynomialSet<ValueType, MonomialType>* F, Monitor* monitor, Reduction* reduction);
+
+    template<class Order, class ValueType, class MonomialType = Monomial>
+    static std::pair<MonomialType, ValueType> get_leading_term(const Polynomial<ValueType, MonomialType>& f);
 
     // returns true if something changed (g ~> g_0 != g)
-    template<class Order, class ValueType>
-    static bool reduce_by(const Polynomial<ValueType>& f, Polynomial<ValueType>* g);
+    template<class Order, class ValueType, class MonomialType = Monomial>
+    static bool reduce_by(const Polynomial<ValueType, MonomialType>& f, Polynomial<ValueType, MonomialType>* g);
+    template<class Order, class ValueType, class Monitor, class MonomialType = Monomial>
+    static bool reduce_by(const Polynomial<ValueType, MonomialType>& f, Polynomial<ValueType, MonomialType>* g, Monitor* monitor);
+
+    template<class Order, class ValueType, class MonomialType = Monomial>
+    static void reduce_by(const PolynomialSet<ValueType, MonomialType>& F, Polynomial<ValueType, MonomialType>* g);
+    template<class Order, class ValueType, class Monitor, class MonomialType = Monomial>
+    static void reduce_by(const PolynomialSet<ValueType, MonomialType>& F, Polynomial<ValueType, MonomialType>* g, Monitor* monitor);
+    template<class Order, class ValueType, class Monitor, class MonomialType = Monomial>
+    static void reduce_by(const PolynomialBasis<ValueType, MonomialType>& F, Polynomial<ValueType, MonomialType>* g, Monitor* monitor);
 
-    template<class Order, class ValueType>
-    static void reduce_by(const PolynomialSet<ValueType>& F, Polynomial<ValueType>* g);
+    // reduces only the leading term of g, until it is not divisible by the leading monomials of
+    // F; the tail of g stays as it is
+    template<class Order, class ValueType, class MonomialType = Monomial>
+    static void top_reduce_by(const PolynomialSet<ValueType, MonomialType>& F, Polynomial<ValueType, MonomialType>* g);
+    template<class Order, class ValueType, class Monitor, class MonomialType = Monomial>
+    static void top_reduce_by(const PolynomialSet<ValueType, MonomialType>& F, Polynomial<ValueType, MonomialType>* g, Monitor* monitor);
+    // leads are the leading terms of F in the order of iteration (get_leading_terms), so that
+    // they are not computed again for every g
+    template<class Order, class ValueType, class Monitor, class MonomialType = Monomial>
+    static void top_reduce_by(const PolynomialSet<ValueType, MonomialType>& F, const std::vector<std::pair<MonomialType, ValueType>>& leads,
+                              Polynomial<ValueType, MonomialType>* g, Monitor* monitor);
 
-    template<class Order, class ValueType>
-    static Polynomial<ValueType> get_S(const Polynomial<ValueType>& f, const Polynomial<ValueType>& g);
+    // leading terms of the elements of F in the order of iteration
+    template<class Order, class ValueType, class MonomialType = Monomial>
+    static std::vector<std::pair<MonomialType, ValueType>> get_leading_terms(const PolynomialSet<ValueType, MonomialType>& F);
+
+    template<class Order, class ValueType, class MonomialType = Monomial>
+    static Polynomial<ValueType, MonomialType> get_S(const Polynomial<ValueType, MonomialType>& f, const Polynomial<ValueType, MonomialType>& g);
+    template<class Order, class ValueType, class Monitor, class MonomialType = Monomial>
+    static Polynomial<ValueType, MonomialType> get_S(const Polynomial<ValueType, MonomialType>& f, const Polynomial<ValueType, MonomialType>& g,
+                                       Monitor* monitor);
 
     static Monomial get_LCM(const Monomial& f, const Monomial& g);
+    static SparseMonomial get_LCM(const SparseMonomial& f, const SparseMonomial& g);
 
 
   private:
     // tries to reduce g by f, returns true if the reduction was made
-    template<class Order, class ValueType>
-    static bool make_reduction_step(const Polynomial<ValueType>& f, const Monomial& f_lead, const ValueType& f_coefficient, Polynomial<ValueType>* g);
+    template<class Order, class ValueType, class Monitor, class MonomialType = Monomial>
+    static bool make_reduction_step(const Polynomial<ValueType, MonomialType>& f, const MonomialType& f_lead, const ValueType& f_coefficient, Polynomial<ValueType, MonomialType>* g, Monitor* monitor);
+
+    // tries to reduce g by F (PolynomialSet or PolynomialBasis), returns true if the reduction was made
+    template<class Order, class Container, class ValueType, class Monitor, class MonomialType = Monomial>
+    static bool make_reduction_step(const Container& F, Polynomial<ValueType, MonomialType>* g, Monitor* monitor);
+
+    template<class Order, class ValueType, class Monitor, class PairFilter, class Reduction, class MonomialType = Monomial>
+    static void add_new_s(const PolynomialSet<ValueType, MonomialType>& F, const Polynomial<ValueType, MonomialType>& new_f, PolynomialSet<ValueType, MonomialType>* set_of_s, Monitor* monitor, PairFilter* filter,
+                          Reduction* reduction);
 
-    // tries to reduce g by F, returns true if the reduction was made
-    template<class Order, class ValueType>
-    static bool make_reduction_step(const PolynomialSet<ValueType>& F, Polynomial<ValueType>* g);
+    // moves the elements of F whose leading monomials are divisible by the leading monomial of
+    // new_f back to set_of_s: auto_reduce would give them new leading monomials, and the pairs
+    // of those are never created, so they are reduced again like S-polynomials
+    template<class Order, class ValueType, class MonomialType = Monomial>
+    static void requeue_reducible(PolynomialSet<ValueType, MonomialType>* F, const Polynomial<ValueType, MonomialType>& new_f,
+                                  PolynomialSet<ValueType, MonomialType>* set_of_s);
 
-    template<class Order, class ValueType>
-    static void add_new_s(const PolynomialSet<ValueType>& F, const Polynomial<ValueType>& new_f, PolynomialSet<ValueType>* set_of_s);
+    // inserts S into set_of_s unless it is zero or already there
+    template<class ValueType, class Monitor, class MonomialType = Monomial>
+    static void insert_s(Polynomial<ValueType, MonomialType>&& S, PolynomialSet<ValueType, MonomialType>* set_of_s, Monitor* monitor);
+
+    // the largest total degree of the terms of f, f is not zero
+    template<class ValueType, class MonomialType = Monomial>
+    static typename MonomialType::DegreeType get_total_degree(const Polynomial<ValueType, MonomialType>& f);
 };
 
+// Reduction policies of the main loop: the arithmetic of S-polynomials, of their reduction by
+// the basis and of auto_reduce. set_basis is called with the basis every time it changes, reduce
+// is called only with it; reduce may leave the tail of g unreduced, reduce_fully may not.
+// normalize brings an element of the basis to its unique form up to which the basis is reduced.
+// FullReduction reduces every term and normalize makes the polynomial monic.
+class FullReduction {
+  public:
+    template<class Order, class ValueType, class MonomialType = Monomial>
+    void set_basis(const PolynomialSet<ValueType, MonomialType>&) {}
+
+    template<class Order, class ValueType, class Monitor, class MonomialType = Monomial>
+    Polynomial<ValueType, MonomialType> get_S(const Polynomial<ValueType, MonomialType>& f, const Polynomial<ValueType, MonomialType>& g,
+                                              Monitor* monitor);
+
+    template<class Order, class ValueType, class Monitor, class MonomialType = Monomial>
+    void reduce(const PolynomialSet<ValueType, MonomialType>& F, Polynomial<ValueType, MonomialType>* g, Monitor* monitor);
+
+    // f is not zero, returns its leading monomial
+    template<class Order, class ValueType, class MonomialType = Monomial>
+    MonomialType normalize(Polynomial<ValueType, MonomialType>* f);
+
+    template<class Order, class ValueType, class Monitor, class MonomialType = Monomial>
+    void reduce_fully(const PolynomialBasis<ValueType, MonomialType>& F, Polynomial<ValueType, MonomialType>* g, Monitor* monitor);
+};
+
+// TopReduction reduces only leading terms, the tail of an S-polynomial is reduced only if it
+// becomes a basis element (by auto_reduce). Saves the tail reductions of the S-polynomials
+// waiting in the queue, but their tails grow, so it pays off when most of the reduction work is
+// on the tails (e.g. LexOrder) and can be slower on dense systems in DegRevLex. The leading
+// terms of the basis are kept between set_basis calls, the rest is the same as in FullReduction.
+template<class ValueType, class MonomialType = Monomial>
+class TopReduction : public FullReduction {
+  public:
+    template<class Order>
+    void set_basis(const PolynomialSet<ValueType, MonomialType>& F);
+
+    template<class Order, class Monitor>
+    void reduce(const PolynomialSet<ValueType, MonomialType>& F, Polynomial<ValueType, MonomialType>* g, Monitor* monitor);
+
+  private:
+    std::vector<std::pair<MonomialType, ValueType>> leads_;
+};
+
+
+template<class Order, class ValueType, class MonomialType>
+void Algorithm::extend_to_grobners_basis(PolynomialSet<ValueType, MonomialType>* F) {
+    NoStatistics statistics;
+    extend_to_grobners_basis<Order>(F, &statistics);
+}
+
+template<class Order, class ValueType, class Monitor, class MonomialType>
+void Algorithm::extend_to_grobners_basis(PolynomialSet<ValueType, MonomialType>* F, Monitor* monitor) {
+    NoPairFilter filter;
+    extend_to_grobners_basis<Order>(F, monitor, &filter);
+}
+
+template<class Order, class ValueType, class Monitor, class PairFilter, class MonomialType>
+void Algorithm::extend_to_grobners_basis(PolynomialSet<ValueType, MonomialType>* F, Monitor* monitor, PairFilter* filter) {
+    FullReduction reduction;
+    extend_to_grobners_basis<Order>(F, monitor, filter, &reduction);
+}
 
-template<class Order, class ValueType>
-void Algorithm::extend_to_grobners_basis(PolynomialSet<ValueType>* F) {
-    auto_reduce<Order>(F);
+template<class Order, class ValueType, class Monitor, class PairFilter, class Reduction, class MonomialType>
+void Algorithm::extend_to_grobners_basis(PolynomialSet<ValueType, MonomialType>* F, Monitor* monitor, PairFilter* filter,
+                                         Reduction* reduction) {
+    auto_reduce<Order>(F, monitor, reduction);
+    monitor->on_basis_changed(*F);
 
-    PolynomialSet<ValueType> set_of_s;
+    // these S-polynomials are not reduced here, the filter sees them when they leave the queue
+    PolynomialSet<ValueType, MonomialType> set_of_s;
     for (auto it = F->pbegin(); it != F->pend(); ++it) {
-        auto S = get_S<Order>(it.first(), it.second());
-        // reduce_by<Order>(*F, &S);
-        if (!S.is_zero()) {
-            set_of_s.insert(S);
-        }
+        monitor->on_pair_created();
+        insert_s(reduction->template get_S<Order>(it.first(), it.second(), monitor), &set_of_s, monitor);
+    }
+    continue_grobners_basis_up_to<Order>(F, &set_of_s, std::numeric_limits<typename MonomialType::DegreeType>::max(),
+                                         monitor, filter, reduction);
+}
+
+template<class Order, class ValueType, class Monitor, class MonomialType>
+void Algorithm::continue_grobners_basis(PolynomialSet<ValueType, MonomialType>* F, PolynomialSet<ValueType, MonomialType>* set_of_s,
+                                        Monitor* monitor) {
+    NoPairFilter filter;
+    continue_grobners_basis<Order>(F, set_of_s, monitor, &filter);
+}
+
+template<class Order, class ValueType, class Monitor, class PairFilter, class MonomialType>
+void Algorithm::continue_grobners_basis(PolynomialSet<ValueType, MonomialType>* F, PolynomialSet<ValueType, MonomialType>* set_of_s,
+                                        Monitor* monitor, PairFilter* filter) {
+    continue_grobners_basis_up_to<Order>(F, set_of_s, std::numeric_limits<typename MonomialType::DegreeType>::max(),
+                                         monitor, filter);
+}
+
+template<class Order, class ValueType, class MonomialType>
+PolynomialSet<ValueType, MonomialType> Algorithm::extend_to_grobners_basis_up_to(
+        PolynomialSet<ValueType, MonomialType>* F, typename MonomialType::DegreeType max_degree) {
+    NoStatistics statistics;
+    return extend_to_grobners_basis_up_to<Order>(F, max_degree, &statistics);
+}
+
+template<class Order, class ValueType, class Monitor, class MonomialType>
+PolynomialSet<ValueType, MonomialType> Algorithm::extend_to_grobners_basis_up_to(
+        PolynomialSet<ValueType, MonomialType>* F, typename MonomialType::DegreeType max_degree, Monitor* monitor) {
+    auto_reduce<Order>(F, monitor);
+    monitor->on_basis_changed(*F);
+
+    PolynomialSet<ValueType, MonomialType> set_of_s;
+    for (auto it = F->pbegin(); it != F->pend(); ++it) {
+        monitor->on_pair_created();
+        insert_s(get_S<Order>(it.first(), it.second(), monitor), &set_of_s, monitor);
     }
-    while (!set_of_s.empty()) {
-        auto S = set_of_s.retrieve_first();
-        reduce_by<Order>(*F, &S);
+    continue_grobners_basis_up_to<Order>(F, &set_of_s, max_degree, monitor);
+    return set_of_s;
+}
+
+template<class Order, class ValueType, class Monitor, class MonomialType>
+void Algorithm::continue_grobners_basis_up_to(PolynomialSet<ValueType, MonomialType>* F, PolynomialSet<ValueType, MonomialType>* set_of_s,
+                                              typename MonomialType::DegreeType max_degree, Monitor* monitor) {
+    NoPairFilter filter;
+    continue_grobners_basis_up_to<Order>(F, set_of_s, max_degree, monitor, &filter);
+}
+
+template<class Order, class ValueType, class Monitor, class PairFilter, class MonomialType>
+void Algorithm::continue_grobners_basis_up_to(PolynomialSet<ValueType, MonomialType>* F, PolynomialSet<ValueType, MonomialType>* set_of_s,
+                                              typename MonomialType::DegreeType max_degree, Monitor* monitor, PairFilter* filter) {
+    FullReduction reduction;
+    continue_grobners_basis_up_to<Order>(F, set_of_s, max_degree, monitor, filter, &reduction);
+}
+
+template<class Order, class ValueType, class Monitor, class PairFilter, class Reduction, class MonomialType>
+void Algorithm::continue_grobners_basis_up_to(PolynomialSet<ValueType, MonomialType>* F, PolynomialSet<ValueType, MonomialType>* set_of_s,
+                                              typename MonomialType::DegreeType max_degree, Monitor* monitor, PairFilter* filter,
+                                              Reduction* reduction) {
+    // S-polynomials above the bound, they go back to set_of_s at the end; without a bound
+    // their degrees are not computed at all
+    PolynomialSet<ValueType, MonomialType> postponed;
+    bool is_bounded = max_degree != std::numeric_limits<typename MonomialType::DegreeType>::max();
+    filter->template set_basis<Order>(*F);
+    reduction->template set_basis<Order>(*F);
+    while (!set_of_s->empty()) {
+        auto S = set_of_s->retrieve_first();
+        if (is_bounded && get_total_degree(S) > max_degree) {
+            postponed.insert(std::move(S));
+            continue;
+        }
+        monitor->on_pair_selected(S);
+        if (filter->template is_reduced_to_zero<Order>(S)) {
+            monitor->on_pair_eliminated(PairCriterion::kFiltered);
+            monitor->on_iteration_finished(*F, *set_of_s);
+            continue;
+        }
+        monitor->on_reduction_started(S);
+        reduction->template reduce<Order>(*F, &S, monitor);
+        monitor->on_reduction_finished(S);
+        filter->on_reduction_finished(S);
         if (!S.is_zero()) {
-            add_new_s<Order>(*F, S, &set_of_s);
-            F->insert(S);
-            auto_reduce<Order>(F);
+            add_new_s<Order>(*F, S, set_of_s, monitor, filter, reduction);
+            requeue_reducible<Order>(F, S, set_of_s);
+            monitor->on_basis_inserted(S);
+            F->insert(std::move(S));
+            auto_reduce<Order>(F, monitor, reduction);
+            monitor->on_basis_changed(*F);
+            filter->template set_basis<Order>(*F);
+            reduction->template set_basis<Order>(*F);
         }
+        monitor->on_iteration_finished(*F, *set_of_s);
     }
-    auto_reduce<Order>(F);
+    *set_of_s = std::move(postponed);
+    auto_reduce<Order>(F, monitor, reduction);
+}
+
+template<class Order, class ValueType, class MonomialType>
+void Algorithm::auto_reduce(PolynomialSet<ValueType, MonomialType>* F) {
+    NoStatistics statistics;
+    auto_reduce<Order>(F, &statistics);
 }
 
-template<class Order, class ValueType>
-void Algorithm::auto_reduce(PolynomialSet<ValueType>* F) {
-    PolynomialSet<ValueType> F1;
-    for (auto f : *F) {
-        auto [monomial, coefficient] = get_leading_term<Order>(f);
-        f /= coefficient;
-        F1.insert(f);
+template<class Order, class ValueType, class Monitor, class MonomialType>
+void Algorithm::auto_reduce(PolynomialSet<ValueType, MonomialType>* F, Monitor* monitor) {
+    FullReduction reduction;
+    auto_reduce<Order>(F, monitor, &reduction);
+}
+
+template<class Order, class ValueType, class Monitor, class Reduction, class MonomialType>
+void Algorithm::auto_reduce(PolynomialSet<ValueType, MonomialType>* F, Monitor* monitor, Reduction* reduction) {
+    monitor->on_phase_started(Phase::kAutoReduce);
+    // polynomials are hashed only when they are put back into F; equal polynomials
+    // don't need to be merged here, the second one is reduced to zero by the first.
+    // Smaller leading monomials go first, so that the order of reductions doesn't depend
+    // on hash values, which also makes the following reductions shorter on most systems
+    std::vector<std::pair<MonomialType, Polynomial<ValueType, MonomialType>>> sorted;
+    sorted.reserve(F->size());
+    while (!F->empty()) {
+        auto f = F->retrieve_first();
+        auto monomial = reduction->template normalize<Order>(&f);
+        sorted.emplace_back(std::move(monomial), std::move(f));
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return Order()(a.first, b.first); });
+    PolynomialBasis<ValueType, MonomialType> basis;
+    for (auto& [monomial, f] : sorted) {
+        basis.insert(std::move(f));
     }
-    *F = F1;
-    for (auto f : F1) {
-        F->erase(f);
-        reduce_by<Order>(*F, &f);
+    auto id_limit = basis.get_id_limit();
+    for (size_t id = 0; id < id_limit; ++id) {
+        auto f = basis.extract(id);
+        reduction->template reduce_fully<Order>(basis, &f, monitor);
         if (!f.is_zero()) {
-            F->insert(f);
+            basis.insert(std::move(f));
         }
     }
+    *F = std::move(basis).to_set();
+    monitor->on_phase_finished(Phase::kAutoReduce);
 }
-
-template<class Order, class ValueType>
-std::pair<Monomial, ValueType> Algorithm::get_leading_term(const Polynomial<ValueType>& f) {
+template<class Order, class ValueType, class MonomialType>
+std::pair<MonomialType, ValueType> Algorithm::get_leading_term(const Polynomial<ValueType, MonomialType>& f) {
     assert(!f.is_zero());
 
     bool is_first = true;
-    Monomial result;
+    MonomialType result;
     ValueType result_coefficient;
 
     for (const auto& [monomial, coefficient] : f) {
@@ -106,29 +374,100 @@ std::pair<Monomial, ValueType> Algorithm::get_leading_term(const Polynomial<Valu
     return {result, result_coefficient};
 }
 
-template<class Order, class ValueType>
-bool Algorithm::reduce_by(const Polynomial<ValueType>& f, Polynomial<ValueType>* g) {
+template<class Order, class ValueType, class MonomialType>
+bool Algorithm::reduce_by(const Polynomial<ValueType, MonomialType>& f, Polynomial<ValueType, MonomialType>* g) {
+    NoStatistics statistics;
+    return reduce_by<Order>(f, g, &statistics);
+}
+
+template<class Order, class ValueType, class Monitor, class MonomialType>
+bool Algorithm::reduce_by(const Polynomial<ValueType, MonomialType>& f, Polynomial<ValueType, MonomialType>* g, Monitor* monitor) {
     assert(!f.is_zero());
     auto [f_lead, f_coefficient] = get_leading_term<Order>(f);
 
     bool something_changed = false;
-    while (make_reduction_step<Order>(f, f_lead, f_coefficient, g)) {
+    while (make_reduction_step<Order>(f, f_lead, f_coefficient, g, monitor)) {
         something_changed = true;
     }
     return something_changed;
 }
 
-template<class Order, class ValueType>
-void Algorithm::reduce_by(const PolynomialSet<ValueType>& F, Polynomial<ValueType>* g) {
-    while (make_reduction_step<Order>(F, g));
+template<class Order, class ValueType, class MonomialType>
+void Algorithm::reduce_by(const PolynomialSet<ValueType, MonomialType>& F, Polynomial<ValueType, MonomialType>* g) {
+    NoStatistics statistics;
+    reduce_by<Order>(F, g, &statistics);
+}
+
+template<class Order, class ValueType, class Monitor, class MonomialType>
+void Algorithm::reduce_by(const PolynomialSet<ValueType, MonomialType>& F, Polynomial<ValueType, MonomialType>* g, Monitor* monitor) {
+    monitor->on_phase_started(Phase::kReduce);
+    while (make_reduction_step<Order>(F, g, monitor));
+    monitor->on_phase_finished(Phase::kReduce);
+}
+
+template<class Order, class ValueType, class Monitor, class MonomialType>
+void Algorithm::reduce_by(const PolynomialBasis<ValueType, MonomialType>& F, Polynomial<ValueType, MonomialType>* g, Monitor* monitor) {
+    monitor->on_phase_started(Phase::kReduce);
+    while (make_reduction_step<Order>(F, g, monitor));
+    monitor->on_phase_finished(Phase::kReduce);
+}
+
+template<class Order, class ValueType, class MonomialType>
+void Algorithm::top_reduce_by(const PolynomialSet<ValueType, MonomialType>& F, Polynomial<ValueType, MonomialType>* g) {
+    NoStatistics statistics;
+    top_reduce_by<Order>(F, g, &statistics);
 }
 
-template<class Order, class ValueType>
-Polynomial<ValueType> Algorithm::get_S(const Polynomial<ValueType>& f, const Polynomial<ValueType>& g) {
+template<class Order, class ValueType, class Monitor, class MonomialType>
+void Algorithm::top_reduce_by(const PolynomialSet<ValueType, MonomialType>& F, Polynomial<ValueType, MonomialType>* g, Monitor* monitor) {
+    top_reduce_by<Order>(F, get_leading_terms<Order>(F), g, monitor);
+}
+
+template<class Order, class ValueType, class Monitor, class MonomialType>
+void Algorithm::top_reduce_by(const PolynomialSet<ValueType, MonomialType>& F, const std::vector<std::pair<MonomialType, ValueType>>& leads,
+                              Polynomial<ValueType, MonomialType>* g, Monitor* monitor) {
+    assert(leads.size() == F.size());
+    monitor->on_phase_started(Phase::kReduce);
+    while (!g->is_zero()) {
+        auto [g_lead, g_coefficient] = get_leading_term<Order>(*g);
+        auto it = F.begin();
+        size_t i = 0;
+        for (; i < leads.size() && !g_lead.is_divisible_by(leads[i].first); ++i, ++it);
+        if (i == leads.size()) {
+            break;
+        }
+        *g -= *it * (g_lead / leads[i].first) * (g_coefficient / leads[i].second);
+        monitor->on_reduction_step();
+    }
+    monitor->on_phase_finished(Phase::kReduce);
+}
+
+template<class Order, class ValueType, class MonomialType>
+std::vector<std::pair<MonomialType, ValueType>> Algorithm::get_leading_terms(const PolynomialSet<ValueType, MonomialType>& F) {
+    std::vector<std::pair<MonomialType, ValueType>> leads;
+    leads.reserve(F.size());
+    for (const auto& f : F) {
+        leads.push_back(get_leading_term<Order>(f));
+    }
+    return leads;
+}
+
+template<class Order, class ValueType, class MonomialType>
+Polynomial<ValueType, MonomialType> Algorithm::get_S(const Polynomial<ValueType, MonomialType>& f, const Polynomial<ValueType, MonomialType>& g) {
+    NoStatistics statistics;
+    return get_S<Order>(f, g, &statistics);
+}
+
+template<class Order, class ValueType, class Monitor, class MonomialType>
+Polynomial<ValueType, MonomialType> Algorithm::get_S(const Polynomial<ValueType, MonomialType>& f, const Polynomial<ValueType, MonomialType>& g,
+                                       Monitor* monitor) {
+    monitor->on_phase_started(Phase::kGetS);
     auto [f_lead, f_coefficient] = get_leading_term<Order>(f);
     auto [g_lead, g_coefficient] = get_leading_term<Order>(g);
     auto lcm = get_LCM(f_lead, g_lead);
-    return f * (lcm / f_lead) / f_coefficient - g * (lcm / g_lead) / g_coefficient;
+    auto result = f * (lcm / f_lead) / f_coefficient - g * (lcm / g_lead) / g_coefficient;
+    monitor->on_phase_finished(Phase::kGetS);
+    return result;
 }
 
 Monomial Algorithm::get_LCM(const Monomial& f, const Monomial& g) {
@@ -139,40 +478,129 @@ Monomial Algorithm::get_LCM(const Monomial& f, const Monomial& g) {
     return result;
 }
 
+inline SparseMonomial Algorithm::get_LCM(const SparseMonomial& f, const SparseMonomial& g) {
+    return SparseMonomial::get_LCM(f, g);
+}
+
 
-template<class Order, class ValueType>
-bool Algorithm::make_reduction_step(const Polynomial<ValueType>& f, const Monomial& f_lead, const ValueType& f_coefficient, Polynomial<ValueType>* g) {
+template<class Order, class ValueType, class Monitor, class MonomialType>
+bool Algorithm::make_reduction_step(const Polynomial<ValueType, MonomialType>& f, const MonomialType& f_lead, const ValueType& f_coefficient, Polynomial<ValueType, MonomialType>* g, Monitor* monitor) {
     for (const auto& [monomial, coefficient] : *g) {
         if (monomial.is_divisible_by(f_lead)) {
             *g -= f * (monomial / f_lead) * (coefficient / f_coefficient);
+            monitor->on_reduction_step();
             return true;
         }
     }
     return false;
 }
 
-template<class Order, class ValueType>
-bool Algorithm::make_reduction_step(const PolynomialSet<ValueType>& F, Polynomial<ValueType>* g) {
+template<class Order, class Container, class ValueType, class Monitor, class MonomialType>
+bool Algorithm::make_reduction_step(const Container& F, Polynomial<ValueType, MonomialType>* g, Monitor* monitor) {
     bool something_changed = false;
     for (const auto& f : F) {
-        if (reduce_by<Order>(f, g)) {
+        if (reduce_by<Order>(f, g, monitor)) {
             something_changed = true;
         }
     }
     return something_changed;
 }
 
-template<class Order, class ValueType>
-void Algorithm::add_new_s(const PolynomialSet<ValueType>& F, const Polynomial<ValueType>& new_f, PolynomialSet<ValueType>* set_of_s) {
+template<class Order, class ValueType, class Monitor, class PairFilter, class Reduction, class MonomialType>
+void Algorithm::add_new_s(const PolynomialSet<ValueType, MonomialType>& F, const Polynomial<ValueType, MonomialType>& new_f, PolynomialSet<ValueType, MonomialType>* set_of_s, Monitor* monitor, PairFilter* filter,
+                          Reduction* reduction) {
     for (const auto& g : F) {
-        auto S = get_S<Order>(new_f, g);
-        reduce_by<Order>(F, &S);
+        monitor->on_pair_created();
+        auto S = reduction->template get_S<Order>(new_f, g, monitor);
+        if (!S.is_zero() && filter->template is_reduced_to_zero<Order>(S)) {
+            monitor->on_pair_eliminated(PairCriterion::kFiltered);
+            continue;
+        }
+        monitor->on_reduction_started(S);
+        reduction->template reduce<Order>(F, &S, monitor);
+        monitor->on_reduction_finished(S);
+        filter->on_reduction_finished(S);
         if (!S.is_zero()) {
-            set_of_s->insert(S);
+            insert_s(std::move(S), set_of_s, monitor);
         }
     }
 }
 
+template<class Order, class ValueType, class MonomialType>
+void Algorithm::requeue_reducible(PolynomialSet<ValueType, MonomialType>* F, const Polynomial<ValueType, MonomialType>& new_f,
+                                  PolynomialSet<ValueType, MonomialType>* set_of_s) {
+    auto lead = get_leading_term<Order>(new_f).first;
+    for (auto it = F->begin(); it != F->end();) {
+        auto next = std::next(it);
+        if (get_leading_term<Order>(*it).first.is_divisible_by(lead)) {
+            set_of_s->insert(F->extract(it));
+        }
+        it = next;
+    }
+}
+
+template<class ValueType, class Monitor, class MonomialType>
+void Algorithm::insert_s(Polynomial<ValueType, MonomialType>&& S, PolynomialSet<ValueType, MonomialType>* set_of_s, Monitor* monitor) {
+    if (S.is_zero()) {
+        monitor->on_pair_eliminated(PairCriterion::kZeroS);
+        return;
+    }
+    size_t size_before = set_of_s->size();
+    set_of_s->insert(std::move(S));
+    if (set_of_s->size() == size_before) {
+        monitor->on_pair_eliminated(PairCriterion::kDuplicate);
+    }
+}
+
+template<class ValueType, class MonomialType>
+typename MonomialType::DegreeType Algorithm::get_total_degree(const Polynomial<ValueType, MonomialType>& f) {
+    assert(!f.is_zero());
+    auto result = std::numeric_limits<typename MonomialType::DegreeType>::min();
+    for (const auto& [monomial, coefficient] : f) {
+        result = std::max(result, monomial.get_degree());
+    }
+    return result;
+}
+
+
+template<class Order, class ValueType, class Monitor, class MonomialType>
+Polynomial<ValueType, MonomialType> FullReduction::get_S(const Polynomial<ValueType, MonomialType>& f,
+                                                         const Polynomial<ValueType, MonomialType>& g, Monitor* monitor) {
+    return Algorithm::get_S<Order>(f, g, monitor);
+}
+
+template<class Order, class ValueType, class Monitor, class MonomialType>
+void FullReduction::reduce(const PolynomialSet<ValueType, MonomialType>& F, Polynomial<ValueType, MonomialType>* g,
+                           Monitor* monitor) {
+    Algorithm::reduce_by<Order>(F, g, monitor);
+}
+
+template<class Order, class ValueType, class MonomialType>
+MonomialType FullReduction::normalize(Polynomial<ValueType, MonomialType>* f) {
+    auto [monomial, coefficient] = Algorithm::get_leading_term<Order>(*f);
+    *f /= coefficient;
+    return monomial;
+}
+
+template<class Order, class ValueType, class Monitor, class MonomialType>
+void FullReduction::reduce_fully(const PolynomialBasis<ValueType, MonomialType>& F, Polynomial<ValueType, MonomialType>* g,
+                                 Monitor* monitor) {
+    Algorithm::reduce_by<Order>(F, g, monitor);
+}
+
+template<class ValueType, class MonomialType>
+template<class Order>
+void TopReduction<ValueType, MonomialType>::set_basis(const PolynomialSet<ValueType, MonomialType>& F) {
+    leads_ = Algorithm::get_leading_terms<Order>(F);
+}
+
+template<class ValueType, class MonomialType>
+template<class Order, class Monitor>
+void TopReduction<ValueType, MonomialType>::reduce(const PolynomialSet<ValueType, MonomialType>& F, Polynomial<ValueType, MonomialType>* g,
+                                                   Monitor* monitor) {
+    Algorithm::top_reduce_by<Order>(F, leads_, g, monitor);
+}
+
 }  // grobner
 
 #endif  // GROBNER_ALGORITHM_H_
@@ -0,0 +1,47 @@
+#include <cstdlib>
+#include <new>
+
+#include "allocation_counter.h"
+
+// Replacement global operator new/delete counting the allocations of the current thread, see
+// AllocationCounter. They are kept out of the headers: a definition visible to the callers lets
+// the compiler pair inlined allocations with the library deallocation functions.
+
+namespace {
+
+void* allocate(size_t size) {
+    grobner::AllocationCounter::record_allocation(size);
+    if (void* result = std::malloc(size == 0 ? 1 : size)) {
+        return result;
+    }
+    throw std::bad_alloc();
+}
+
+const bool is_registered = (grobner::AllocationCounter::enable(), true);
+
+}  // namespace
+
+
+void* operator new(size_t size) {
+    return allocate(size);
+}
+
+void* operator new[](size_t size) {
+    return allocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
@@ -0,0 +1,53 @@
+#ifndef GROBNER_ALLOCATION_COUNTER_H_
+#define GROBNER_ALLOCATION_COUNTER_H_
+
+#include <cstddef>
+
+// Counts allocations made by the current thread. The counts are recorded by the replacement
+// global operator new/delete from allocation_counter.cpp, which has to be linked into the binary
+// (g++ main.cpp allocation_counter.cpp); without it is_enabled() is false and the counts stay 0.
+
+namespace grobner {
+
+class AllocationCounter {
+  public:
+    static size_t get_allocation_count();
+    static size_t get_allocated_bytes();
+
+    static void record_allocation(size_t size);
+
+    // the replacement operators are linked
+    static bool is_enabled();
+    static void enable();
+
+  private:
+    inline static thread_local size_t allocation_count_ = 0;
+    inline static thread_local size_t allocated_bytes_ = 0;
+    inline static bool is_enabled_ = false;
+};
+
+
+inline size_t AllocationCounter::get_allocation_count() {
+    return allocation_count_;
+}
+
+inline size_t AllocationCounter::get_allocated_bytes() {
+    return allocated_bytes_;
+}
+
+inline void AllocationCounter::record_allocation(size_t size) {
+    ++allocation_count_;
+    allocated_bytes_ += size;
+}
+
+inline bool AllocationCounter::is_enabled() {
+    return is_enabled_;
+}
+
+inline void AllocationCounter::enable() {
+    is_enabled_ = true;
+}
+
+}  // grobner
+
+#endif  // GROBNER_ALLOCATION_COUNTER_H_
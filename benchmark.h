@@ -0,0 +1,412 @@
+#ifndef GROBNER_BENCHMARK_H_
+#define GROBNER_BENCHMARK_H_
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/rational.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "algorithm.h"
+#include "benchmark_systems.h"
+#include "dyn_modular.h"
+#include "fraction_free.h"
+#include "hybrid_rational.h"
+#include "modular.h"
+#include "modular_pair_filter.h"
+#include "monomial_order.h"
+#include "polynomial_set.h"
+#include "small_modular.h"
+#include "statistics.h"
+#include "stopwatch.h"
+#include "tracer.h"
+
+namespace grobner {
+
+struct BenchmarkOptions {
+    // "name:size", see BenchmarkSystems::get_system
+    std::vector<std::string> systems = {"cyclic:4", "katsura:2", "eco:4", "noon:2", "reimer:2",
+                                        "random_dense:2", "random_sparse:2"};
+    // modular, dyn_modular (DynModular with the same prime), small_modular (SmallModular<65521>), rational, big_rational, hybrid (HybridRational),
+    // fraction_free (big_rational with FractionFreeAlgorithm), modular_filter (big_rational with ModularPairFilter); rational (boost::rational<long long>) overflows on most
+    // non-trivial systems, so it is not run by default
+    std::vector<std::string> fields = {"modular", "big_rational", "hybrid", "fraction_free"};
+    // lex, deglex, degrevlex
+    std::vector<std::string> orders = {"lex", "deglex", "degrevlex"};
+    int repetitions = 3;
+    unsigned seed = 0;
+    // results are printed to stdout if empty
+    std::string output_path;
+    // results of a previous run to compare with
+    std::string baseline_path;
+    // chrome trace of the runs that collect counters
+    std::string trace_path;
+    // relative slowdown of the median wall time that is reported as a regression
+    double tolerance = 0.1;
+    // smaller absolute differences are considered noise
+    double min_difference_seconds = 0.005;
+};
+
+struct BenchmarkResult {
+    std::string system;
+    int size = 0;
+    std::string field;
+    std::string order;
+    std::vector<double> wall_seconds;
+    std::vector<double> cpu_seconds;
+    // of the run that collects counters, or of the whole process so far if the peak can't be
+    // reset on this system (is_peak_rss_per_run is false)
+    long peak_rss_kb = 0;
+    bool is_peak_rss_per_run = false;
+    std::vector<std::pair<std::string, double>> counters;
+    // set if the run threw, for example on boost::rational<long long> overflow
+    std::string error;
+
+    inline std::string get_key() const;
+    inline static double get_median(std::vector<double> values);
+};
+
+class Benchmark {
+  public:
+    // parses "--systems cyclic:4,eco:5 --fields modular --orders lex --repetitions 5
+    //         --output out.json --baseline base.json --tolerance 0.1 --seed 1 --trace trace.json"
+    inline static BenchmarkOptions parse_options(int argc, char** argv);
+
+    // runs everything and compares with the baseline, returns non-zero exit code on regressions
+    inline static int run(const BenchmarkOptions& options);
+
+    // events of the counter runs are recorded into tracer if it is not null
+    inline static std::vector<BenchmarkResult> run_all(const BenchmarkOptions& options, Tracer* tracer = nullptr);
+
+    // AlgorithmType is Algorithm, FractionFreeAlgorithm or ModularFilteredAlgorithm
+    template<class ValueType, class Order, class AlgorithmType = Algorithm>
+    inline static BenchmarkResult run_one(const std::string& system, int size, int repetitions, unsigned seed,
+                                          Tracer* tracer = nullptr);
+
+    inline static void write_json(std::ostream& out, const std::vector<BenchmarkResult>& results);
+    // reads median wall times from the output of write_json
+    inline static std::map<std::string, double> read_baseline(std::istream& in);
+    // returns number of regressions
+    inline static int compare_with_baseline(const std::vector<BenchmarkResult>& results,
+                                            const std::map<std::string, double>& baseline,
+                                            const BenchmarkOptions& options);
+
+  private:
+    template<class ValueType, class AlgorithmType = Algorithm>
+    inline static BenchmarkResult run_one(const std::string& system, int size, const std::string& order,
+                                          int repetitions, unsigned seed, Tracer* tracer);
+
+    inline static std::vector<std::string> split(const std::string& s, char delimiter);
+    inline static std::string escape(const std::string& s);
+    inline static void write_array(std::ostream& out, const std::vector<double>& values);
+};
+
+
+std::string BenchmarkResult::get_key() const {
+    return system + "(" + std::to_string(size) + ")/" + field + "/" + order;
+}
+
+double BenchmarkResult::get_median(std::vector<double> values) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    if (values.size() % 2 == 1) {
+        return values[values.size() / 2];
+    }
+    return (values[values.size() / 2 - 1] + values[values.size() / 2]) / 2;
+}
+
+
+BenchmarkOptions Benchmark::parse_options(int argc, char** argv) {
+    BenchmarkOptions options;
+    for (int i = 0; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        std::string value = argv[i + 1];
+        if (key == "--systems") {
+            options.systems = split(value, ',');
+        } else if (key == "--fields") {
+            options.fields = split(value, ',');
+        } else if (key == "--orders") {
+            options.orders = split(value, ',');
+        } else if (key == "--repetitions") {
+            options.repetitions = std::stoi(value);
+        } else if (key == "--seed") {
+            options.seed = std::stoul(value);
+        } else if (key == "--output") {
+            options.output_path = value;
+        } else if (key == "--baseline") {
+            options.baseline_path = value;
+        } else if (key == "--trace") {
+            options.trace_path = value;
+        } else if (key == "--tolerance") {
+            options.tolerance = std::stod(value);
+        } else {
+            std::cerr << "Unknown option: " << key << std::endl;
+            std::exit(1);
+        }
+    }
+    if (argc % 2 == 1) {
+        std::cerr << "Missing value for option " << argv[argc - 1] << std::endl;
+        std::exit(1);
+    }
+    return options;
+}
+
+int Benchmark::run(const BenchmarkOptions& options) {
+    Tracer tracer;
+    auto results = run_all(options, options.trace_path.empty() ? nullptr : &tracer);
+
+    if (options.output_path.empty()) {
+        write_json(std::cout, results);
+    } else {
+        std::ofstream out(options.output_path);
+        write_json(out, results);
+    }
+    if (!options.trace_path.empty()) {
+        std::ofstream out(options.trace_path);
+        tracer.write_chrome_json(out);
+    }
+
+    if (options.baseline_path.empty()) {
+        return 0;
+    }
+    std::ifstream in(options.baseline_path);
+    if (!in) {
+        std::cerr << "Can't open baseline " << options.baseline_path << std::endl;
+        return 1;
+    }
+    return compare_with_baseline(results, read_baseline(in), options) == 0 ? 0 : 1;
+}
+
+std::vector<BenchmarkResult> Benchmark::run_all(const BenchmarkOptions& options, Tracer* tracer) {
+    using Modular = grobner::Modular<1'000'000'007ll>;
+    using Rational = boost::rational<long long>;
+    using BigRational = boost::rational<boost::multiprecision::cpp_int>;
+
+    std::vector<BenchmarkResult> results;
+    for (const auto& system : options.systems) {
+        auto parts = split(system, ':');
+        if (parts.size() != 2) {
+            std::cerr << "Expected name:size, got " << system << std::endl;
+            std::exit(1);
+        }
+        int size = std::stoi(parts[1]);
+        for (const auto& field : options.fields) {
+            for (const auto& order : options.orders) {
+                std::cerr << "Running " << parts[0] << "(" << size << ")/" << field << "/" << order << "..."
+                          << std::endl;
+                BenchmarkResult result;
+                if (field == "modular") {
+                    result = run_one<Modular>(parts[0], size, order, options.repetitions, options.seed, tracer);
+                } else if (field == "dyn_modular") {
+                    PrimeField prime_field(1'000'000'007ll);
+                    DynModular::FieldScope scope(prime_field);
+                    result = run_one<DynModular>(parts[0], size, order, options.repetitions, options.seed, tracer);
+                } else if (field == "small_modular") {
+                    result = run_one<SmallModular<65521>>(parts[0], size, order, options.repetitions, options.seed,
+                                                          tracer);
+                } else if (field == "rational") {
+                    result = run_one<Rational>(parts[0], size, order, options.repetitions, options.seed, tracer);
+                } else if (field == "big_rational") {
+                    result = run_one<BigRational>(parts[0], size, order, options.repetitions, options.seed, tracer);
+                } else if (field == "hybrid") {
+                    result = run_one<HybridRational>(parts[0], size, order, options.repetitions, options.seed, tracer);
+                } else if (field == "modular_filter") {
+                    result = run_one<BigRational, ModularFilteredAlgorithm>(parts[0], size, order, options.repetitions,
+                                                                            options.seed, tracer);
+                } else if (field == "fraction_free") {
+                    result = run_one<BigRational, FractionFreeAlgorithm>(parts[0], size, order, options.repetitions,
+                                                                         options.seed, tracer);
+                } else {
+                    std::cerr << "Unknown field: " << field << std::endl;
+                    std::exit(1);
+                }
+                result.field = field;
+                results.push_back(result);
+            }
+        }
+    }
+    return results;
+}
+
+template<class ValueType, class AlgorithmType>
+BenchmarkResult Benchmark::run_one(const std::string& system, int size, const std::string& order,
+                                   int repetitions, unsigned seed, Tracer* tracer) {
+    using Lex = LexOrder;
+    using DegLex = OrderSum<DegOrder, LexOrder>;
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    BenchmarkResult result;
+    if (order == "lex") {
+        result = run_one<ValueType, Lex, AlgorithmType>(system, size, repetitions, seed, tracer);
+    } else if (order == "deglex") {
+        result = run_one<ValueType, DegLex, AlgorithmType>(system, size, repetitions, seed, tracer);
+    } else if (order == "degrevlex") {
+        result = run_one<ValueType, DegRevLex, AlgorithmType>(system, size, repetitions, seed, tracer);
+    } else {
+        std::cerr << "Unknown order: " << order << std::endl;
+        std::exit(1);
+    }
+    result.order = order;
+    return result;
+}
+
+template<class ValueType, class Order, class AlgorithmType>
+BenchmarkResult Benchmark::run_one(const std::string& system, int size, int repetitions, unsigned seed,
+                                   Tracer* tracer) {
+    BenchmarkResult result;
+    result.system = system;
+    result.size = size;
+    for (int repetition = 0; repetition < repetitions; ++repetition) {
+        auto F = BenchmarkSystems::get_system<ValueType>(system, size, seed);
+        Stopwatch stopwatch;
+        try {
+            AlgorithmType::template extend_to_grobners_basis<Order>(&F);
+        } catch (const std::exception& e) {
+            result.error = e.what();
+            return result;
+        }
+        result.wall_seconds.push_back(stopwatch.get_wall_seconds());
+        result.cpu_seconds.push_back(stopwatch.get_cpu_seconds());
+    }
+
+    // counters are collected by a separate run, so that they don't affect the timings
+    auto F = BenchmarkSystems::get_system<ValueType>(system, size, seed);
+    Statistics statistics;
+    result.is_peak_rss_per_run = Stopwatch::reset_peak_rss();
+    if (tracer != nullptr) {
+        CombinedMonitor<Statistics, Tracer> monitor(&statistics, tracer);
+        AlgorithmType::template extend_to_grobners_basis<Order>(&F, &monitor);
+    } else {
+        AlgorithmType::template extend_to_grobners_basis<Order>(&F, &statistics);
+    }
+    size_t terms = 0;
+    for (const auto& f : F) {
+        terms += f.size();
+    }
+    result.counters = statistics.get_counters();
+    result.counters.emplace_back("basis_size", F.size());
+    result.counters.emplace_back("basis_terms", terms);
+    result.peak_rss_kb = Stopwatch::get_peak_rss_kb();
+    return result;
+}
+
+void Benchmark::write_json(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+    // one result per line, read_baseline relies on it
+    out << std::setprecision(9);
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+        out << "  {\"key\": \"" << escape(result.get_key()) << "\", "
+            << "\"system\": \"" << escape(result.system) << "\", "
+            << "\"size\": " << result.size << ", "
+            << "\"field\": \"" << escape(result.field) << "\", "
+            << "\"order\": \"" << escape(result.order) << "\", "
+            << "\"repetitions\": " << result.wall_seconds.size() << ", "
+            << "\"median_wall_seconds\": " << BenchmarkResult::get_median(result.wall_seconds) << ", "
+            << "\"median_cpu_seconds\": " << BenchmarkResult::get_median(result.cpu_seconds) << ", "
+            << "\"wall_seconds\": ";
+        write_array(out, result.wall_seconds);
+        out << ", \"cpu_seconds\": ";
+        write_array(out, result.cpu_seconds);
+        out << ", \"peak_rss_kb\": " << result.peak_rss_kb
+            << ", \"peak_rss_scope\": \"" << (result.is_peak_rss_per_run ? "run" : "process") << "\""
+            << ", \"counters\": {";
+        for (size_t j = 0; j < result.counters.size(); ++j) {
+            if (j != 0) {
+                out << ", ";
+            }
+            out << "\"" << escape(result.counters[j].first) << "\": " << result.counters[j].second;
+        }
+        out << "}";
+        if (!result.error.empty()) {
+            out << ", \"error\": \"" << escape(result.error) << "\"";
+        }
+        out << "}" << (i + 1 == results.size() ? "" : ",") << "\n";
+    }
+    out << "]\n";
+}
+
+std::map<std::string, double> Benchmark::read_baseline(std::istream& in) {
+    const std::string key_prefix = "{\"key\": \"";
+    const std::string median_prefix = "\"median_wall_seconds\": ";
+
+    std::map<std::string, double> baseline;
+    std::string line;
+    while (std::getline(in, line)) {
+        auto key_position = line.find(key_prefix);
+        auto median_position = line.find(median_prefix);
+        if (key_position == std::string::npos || median_position == std::string::npos ||
+                line.find("\"error\"") != std::string::npos) {
+            continue;
+        }
+        key_position += key_prefix.size();
+        auto key = line.substr(key_position, line.find('"', key_position) - key_position);
+        baseline[key] = std::stod(line.substr(median_position + median_prefix.size()));
+    }
+    return baseline;
+}
+
+int Benchmark::compare_with_baseline(const std::vector<BenchmarkResult>& results,
+                                     const std::map<std::string, double>& baseline,
+                                     const BenchmarkOptions& options) {
+    int regressions = 0;
+    for (const auto& result : results) {
+        auto it = baseline.find(result.get_key());
+        if (it == baseline.end() || !result.error.empty()) {
+            continue;
+        }
+        double current = BenchmarkResult::get_median(result.wall_seconds);
+        double previous = it->second;
+        bool is_regression = current > previous * (1 + options.tolerance) &&
+                             current - previous > options.min_difference_seconds;
+        std::cerr << (is_regression ? "REGRESSION " : "ok         ") << result.get_key() << ": "
+                  << previous << "s -> " << current << "s" << std::endl;
+        if (is_regression) {
+            ++regressions;
+        }
+    }
+    return regressions;
+}
+
+std::vector<std::string> Benchmark::split(const std::string& s, char delimiter) {
+    std::vector<std::string> result;
+    std::stringstream ss(s);
+    std::string part;
+    while (std::getline(ss, part, delimiter)) {
+        result.push_back(part);
+    }
+    return result;
+}
+
+std::string Benchmark::escape(const std::string& s) {
+    std::string result;
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+        }
+        result += c;
+    }
+    return result;
+}
+
+void Benchmark::write_array(std::ostream& out, const std::vector<double>& values) {
+    out << "[";
+    for (size_t i = 0; i < values.size(); ++i) {
+        out << (i == 0 ? "" : ", ") << values[i];
+    }
+    out << "]";
+}
+
+}  // grobner
+
+#endif  // GROBNER_BENCHMARK_H_
@@ -0,0 +1,242 @@
+#ifndef GROBNER_BENCHMARK_SYSTEMS_H_
+#define GROBNER_BENCHMARK_SYSTEMS_H_
+
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "monomial.h"
+#include "polynomial.h"
+#include "polynomial_set.h"
+
+namespace grobner {
+
+// classic benchmark families, variables are numbered from 0
+class BenchmarkSystems {
+  public:
+    template<class ValueType>
+    inline static PolynomialSet<ValueType> get_system(const std::string& name, int size, unsigned seed = 0);
+
+    template<class ValueType>
+    inline static PolynomialSet<ValueType> get_cyclic(int variable_count);
+    // x_0..x_n, sum_{l=-n}^{n} x_|l| x_|m-l| = x_m for m < n and x_0 + 2 sum x_l = 1
+    template<class ValueType>
+    inline static PolynomialSet<ValueType> get_katsura(int n);
+    template<class ValueType>
+    inline static PolynomialSet<ValueType> get_eco(int variable_count);
+    // 10 x_i sum_{j != i} x_j^2 - 11 x_i + 10, i.e. the usual coefficient 1.1 scaled by 10
+    template<class ValueType>
+    inline static PolynomialSet<ValueType> get_noon(int variable_count);
+    template<class ValueType>
+    inline static PolynomialSet<ValueType> get_reimer(int variable_count);
+    // all monomials of degree <= degree with random coefficients
+    template<class ValueType>
+    inline static PolynomialSet<ValueType> get_random_dense(int variable_count, int degree, unsigned seed);
+    // term_count random monomials of degree <= degree per generator
+    template<class ValueType>
+    inline static PolynomialSet<ValueType> get_random_sparse(int variable_count, int degree, int term_count, unsigned seed);
+
+    template<class ValueType>
+    inline static Polynomial<ValueType> get_sigma(int variable_count, int sigma_index);
+
+  private:
+    inline static Monomial get_variable(int i, int degree = 1);
+    inline static void get_all_monomials(int variable_count, int degree, Monomial current, int first_variable,
+                                         std::vector<Monomial>* result);
+    template<class ValueType>
+    inline static ValueType get_random_coefficient(std::mt19937* random);
+};
+
+
+template<class ValueType>
+PolynomialSet<ValueType> BenchmarkSystems::get_system(const std::string& name, int size, unsigned seed) {
+    if (name == "cyclic") {
+        return get_cyclic<ValueType>(size);
+    } else if (name == "katsura") {
+        return get_katsura<ValueType>(size);
+    } else if (name == "eco") {
+        return get_eco<ValueType>(size);
+    } else if (name == "noon") {
+        return get_noon<ValueType>(size);
+    } else if (name == "reimer") {
+        return get_reimer<ValueType>(size);
+    } else if (name == "random_dense") {
+        return get_random_dense<ValueType>(size, 2, seed);
+    } else if (name == "random_sparse") {
+        return get_random_sparse<ValueType>(size, 3, 4, seed);
+    }
+    std::cerr << "Unknown system: " << name << std::endl;
+    std::exit(1);
+}
+
+template<class ValueType>
+PolynomialSet<ValueType> BenchmarkSystems::get_cyclic(int variable_count) {
+    PolynomialSet<ValueType> result;
+    for (int i = 1; i < variable_count; ++i) {
+        result.insert(get_sigma<ValueType>(variable_count, i));
+    }
+    if (variable_count % 2 == 0) {
+        result.insert(get_sigma<ValueType>(variable_count, variable_count) + ValueType(1));
+    } else {
+        result.insert(get_sigma<ValueType>(variable_count, variable_count) - ValueType(1));
+    }
+    return result;
+}
+
+template<class ValueType>
+PolynomialSet<ValueType> BenchmarkSystems::get_katsura(int n) {
+    PolynomialSet<ValueType> result;
+    for (int m = 0; m < n; ++m) {
+        Polynomial<ValueType> f;
+        for (int l = -n; l <= n; ++l) {
+            int i = std::abs(l);
+            int j = std::abs(m - l);
+            if (i <= n && j <= n) {
+                f.add_monomial(get_variable(i) * get_variable(j));
+            }
+        }
+        f.add_monomial(get_variable(m), ValueType(-1));
+        result.insert(f);
+    }
+    Polynomial<ValueType> f(ValueType(-1));
+    f.add_monomial(get_variable(0));
+    for (int l = 1; l <= n; ++l) {
+        f.add_monomial(get_variable(l), ValueType(2));
+    }
+    result.insert(f);
+    return result;
+}
+
+template<class ValueType>
+PolynomialSet<ValueType> BenchmarkSystems::get_eco(int variable_count) {
+    PolynomialSet<ValueType> result;
+    int n = variable_count;
+    for (int k = 1; k < n; ++k) {
+        Polynomial<ValueType> f(ValueType(-k));
+        f.add_monomial(get_variable(k - 1) * get_variable(n - 1));
+        for (int i = 1; i + k < n; ++i) {
+            f.add_monomial(get_variable(i - 1) * get_variable(i + k - 1) * get_variable(n - 1));
+        }
+        result.insert(f);
+    }
+    Polynomial<ValueType> f(ValueType(1));
+    for (int i = 0; i + 1 < n; ++i) {
+        f.add_monomial(get_variable(i));
+    }
+    result.insert(f);
+    return result;
+}
+
+template<class ValueType>
+PolynomialSet<ValueType> BenchmarkSystems::get_noon(int variable_count) {
+    PolynomialSet<ValueType> result;
+    for (int i = 0; i < variable_count; ++i) {
+        Polynomial<ValueType> f(ValueType(10));
+        f.add_monomial(get_variable(i), ValueType(-11));
+        for (int j = 0; j < variable_count; ++j) {
+            if (j != i) {
+                f.add_monomial(get_variable(i) * get_variable(j, 2), ValueType(10));
+            }
+        }
+        result.insert(f);
+    }
+    return result;
+}
+
+template<class ValueType>
+PolynomialSet<ValueType> BenchmarkSystems::get_reimer(int variable_count) {
+    PolynomialSet<ValueType> result;
+    for (int power = 2; power <= variable_count + 1; ++power) {
+        Polynomial<ValueType> f(ValueType(-1));
+        for (int j = 0; j < variable_count; ++j) {
+            f.add_monomial(get_variable(j, power), ValueType(j % 2 == 0 ? 2 : -2));
+        }
+        result.insert(f);
+    }
+    return result;
+}
+
+template<class ValueType>
+PolynomialSet<ValueType> BenchmarkSystems::get_random_dense(int variable_count, int degree, unsigned seed) {
+    std::mt19937 random(seed);
+    std::vector<Monomial> monomials;
+    get_all_monomials(variable_count, degree, Monomial(), 0, &monomials);
+
+    PolynomialSet<ValueType> result;
+    for (int i = 0; i < variable_count; ++i) {
+        Polynomial<ValueType> f;
+        for (const auto& monomial : monomials) {
+            f.add_monomial(monomial, get_random_coefficient<ValueType>(&random));
+        }
+        if (!f.is_zero()) {
+            result.insert(f);
+        }
+    }
+    return result;
+}
+
+template<class ValueType>
+PolynomialSet<ValueType> BenchmarkSystems::get_random_sparse(int variable_count, int degree, int term_count,
+                                                             unsigned seed) {
+    std::mt19937 random(seed);
+    PolynomialSet<ValueType> result;
+    for (int i = 0; i < variable_count; ++i) {
+        Polynomial<ValueType> f(get_random_coefficient<ValueType>(&random));
+        for (int term = 0; term < term_count; ++term) {
+            Monomial monomial;
+            int monomial_degree = std::uniform_int_distribution<int>(1, degree)(random);
+            for (int d = 0; d < monomial_degree; ++d) {
+                monomial *= get_variable(std::uniform_int_distribution<int>(0, variable_count - 1)(random));
+            }
+            f.add_monomial(monomial, get_random_coefficient<ValueType>(&random));
+        }
+        if (!f.is_zero()) {
+            result.insert(f);
+        }
+    }
+    return result;
+}
+
+template<class ValueType>
+Polynomial<ValueType> BenchmarkSystems::get_sigma(int variable_count, int sigma_index) {
+    if (sigma_index == 0) {
+        return Polynomial<ValueType>(1);
+    }
+    if (variable_count == sigma_index) {
+        Monomial sigma;
+        for (int i = 0; i < variable_count; ++i) {
+            sigma.set_degree(i, 1);
+        }
+        return Polynomial<ValueType>(sigma);
+    }
+    return get_sigma<ValueType>(variable_count - 1, sigma_index) +
+           get_sigma<ValueType>(variable_count - 1, sigma_index - 1) * get_variable(variable_count - 1);
+}
+
+
+Monomial BenchmarkSystems::get_variable(int i, int degree) {
+    Monomial result;
+    result.set_degree(i, degree);
+    return result;
+}
+
+void BenchmarkSystems::get_all_monomials(int variable_count, int degree, Monomial current, int first_variable,
+                                         std::vector<Monomial>* result) {
+    result->push_back(current);
+    if (degree == 0) {
+        return;
+    }
+    for (int i = first_variable; i < variable_count; ++i) {
+        get_all_monomials(variable_count, degree - 1, current * get_variable(i), i, result);
+    }
+}
+
+template<class ValueType>
+ValueType BenchmarkSystems::get_random_coefficient(std::mt19937* random) {
+    return ValueType(std::uniform_int_distribution<int>(-100, 100)(*random));
+}
+
+}  // grobner
+
+#endif  // GROBNER_BENCHMARK_SYSTEMS_H_
@@ -0,0 +1,396 @@
+#ifndef GROBNER_BOOLEAN_ALGORITHM_H_
+#define GROBNER_BOOLEAN_ALGORITHM_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "boolean_monomial.h"
+#include "boolean_polynomial.h"
+#include "hashes.h"
+#include "statistics.h"
+
+namespace grobner {
+
+// Grobner bases of ideals of the boolean ring, i.e. of F together with the field equations
+// x^2 = x of all variables. Pairs are processed in batches of the smallest degree, like in F4:
+// their S-polynomials and the multiples of basis elements needed to reduce them (reducers) are
+// rows of a matrix over GF(2) with a bit per monomial, and the S-polynomials are reduced by the
+// reducers and by each other with XOR of whole words, 64 monomials at a time. Products by a
+// variable of the leading monomial (the pairs with field equations) can lose their leading
+// term, so they are never used as reducers. Orders must be supported by BooleanOrder.
+// Monitors get pairs, reduction steps (row additions) and phases: kGetS is the selection of
+// reducers, kReduce the elimination, kAutoReduce the final inter-reduction.
+class BooleanAlgorithm {
+  public:
+    // F is replaced by the reduced Grobner basis sorted by leading monomials from the smallest
+    template<class Order>
+    static void extend_to_grobners_basis(std::vector<BooleanPolynomial<Order>>* F);
+    template<class Order, class Monitor>
+    static void extend_to_grobners_basis(std::vector<BooleanPolynomial<Order>>* F, Monitor* monitor);
+
+    // the nonzero rows of the reduced row echelon form of polynomials as vectors over GF(2),
+    // sorted by leading monomials from the largest
+    template<class Order>
+    static std::vector<BooleanPolynomial<Order>> eliminate(const std::vector<BooleanPolynomial<Order>>& rows);
+    template<class Order, class Monitor>
+    static std::vector<BooleanPolynomial<Order>> eliminate(const std::vector<BooleanPolynomial<Order>>& rows,
+                                                           Monitor* monitor);
+    // the same for rows reduced by reducers, which must have distinct leading monomials;
+    // the reducers are not changed and not returned
+    template<class Order, class Monitor>
+    static std::vector<BooleanPolynomial<Order>> eliminate(const std::vector<BooleanPolynomial<Order>>& reducers,
+                                                           const std::vector<BooleanPolynomial<Order>>& rows,
+                                                           Monitor* monitor);
+
+  private:
+    using Word = BooleanMonomial::Word;
+    static constexpr size_t kFieldEquation = SIZE_MAX;
+
+    // S-polynomial of two basis elements, or the product of first by variable if second is kFieldEquation
+    struct Pair {
+        size_t first;
+        size_t second;
+        size_t variable;
+        BooleanMonomial lcm;
+        size_t degree;
+    };
+
+    // adds h to the basis and updates pairs with the criteria of Gebauer and Moller; basis elements
+    // whose leading monomial is divisible by the one of h stay reducers, but get no new pairs
+    template<class Order, class Monitor>
+    static void insert(BooleanPolynomial<Order> h, std::vector<BooleanPolynomial<Order>>* basis,
+                       std::vector<bool>* is_active, std::vector<Pair>* pairs, Monitor* monitor);
+
+    // adds to reducers multiples of basis elements, so that every monomial of rows and reducers
+    // divisible by a leading monomial of the basis, except the kept ones, is the leading monomial
+    // of a reducer, then eliminates
+    template<class Order, class Monitor>
+    static std::vector<BooleanPolynomial<Order>> reduce(const std::vector<BooleanPolynomial<Order>>& basis,
+                                                        std::vector<BooleanPolynomial<Order>> reducers,
+                                                        const std::vector<BooleanPolynomial<Order>>& rows,
+                                                        const std::unordered_set<BooleanMonomial, hash<BooleanMonomial>>& kept,
+                                                        Monitor* monitor);
+
+    template<class Order>
+    static bool is_reducible(const BooleanMonomial& monomial, const std::vector<BooleanPolynomial<Order>>& basis);
+};
+
+
+template<class Order>
+void BooleanAlgorithm::extend_to_grobners_basis(std::vector<BooleanPolynomial<Order>>* F) {
+    NoStatistics statistics;
+    extend_to_grobners_basis<Order>(F, &statistics);
+}
+
+template<class Order, class Monitor>
+void BooleanAlgorithm::extend_to_grobners_basis(std::vector<BooleanPolynomial<Order>>* F, Monitor* monitor) {
+    std::vector<BooleanPolynomial<Order>> basis;
+    std::vector<bool> is_active;
+    std::vector<Pair> pairs;
+    for (auto& h : eliminate<Order>(*F, monitor)) {
+        insert<Order>(std::move(h), &basis, &is_active, &pairs, monitor);
+    }
+
+    while (!pairs.empty()) {
+        // normal strategy: all pairs of the smallest degree
+        auto degree = std::min_element(pairs.begin(), pairs.end(), [](const auto& a, const auto& b) {
+            return a.degree < b.degree;
+        })->degree;
+        auto selected_end = std::partition(pairs.begin(), pairs.end(), [degree](const auto& pair) {
+            return pair.degree == degree;
+        });
+        std::vector<Pair> selected(pairs.begin(), selected_end);
+        pairs.erase(pairs.begin(), selected_end);
+
+        // the first multiple with a given lcm is the reducer of this monomial, the others are rows,
+        // so that every S-polynomial is their difference; the same multiple is added once
+        std::vector<BooleanPolynomial<Order>> reducers;
+        std::vector<BooleanPolynomial<Order>> rows;
+        std::unordered_map<BooleanMonomial, std::vector<size_t>, hash<BooleanMonomial>> multiples;
+        for (const auto& pair : selected) {
+            if (pair.second == kFieldEquation) {
+                rows.push_back(basis[pair.first] * BooleanMonomial{pair.variable});
+                continue;
+            }
+            const auto& lcm = pair.lcm;
+            auto& indices = multiples[lcm];
+            for (auto index : {pair.first, pair.second}) {
+                if (std::find(indices.begin(), indices.end(), index) != indices.end()) {
+                    continue;
+                }
+                auto multiple = basis[index] * (lcm / basis[index].get_leading_monomial());
+                (indices.empty() ? reducers : rows).push_back(std::move(multiple));
+                indices.push_back(index);
+            }
+        }
+        // leading monomials of the reduced rows are not divisible by the leading monomials of the basis
+        for (auto& h : reduce<Order>(basis, std::move(reducers), rows, {}, monitor)) {
+            if (h.get_leading_monomial() == BooleanMonomial()) {
+                // the unit: the ideal is the whole ring
+                basis.assign(1, std::move(h));
+                pairs.clear();
+                break;
+            }
+            insert<Order>(std::move(h), &basis, &is_active, &pairs, monitor);
+        }
+    }
+
+    monitor->on_phase_started(Phase::kAutoReduce);
+    std::sort(basis.begin(), basis.end(), [](const auto& a, const auto& b) {
+        return BooleanOrder<Order>()(a.get_leading_monomial(), b.get_leading_monomial());
+    });
+    std::vector<BooleanPolynomial<Order>> minimal;
+    std::unordered_set<BooleanMonomial, hash<BooleanMonomial>> leads;
+    for (auto& f : basis) {
+        if (!is_reducible<Order>(f.get_leading_monomial(), minimal)) {
+            leads.insert(f.get_leading_monomial());
+            minimal.push_back(std::move(f));
+        }
+    }
+    // the leading monomials of the minimal basis stay pivots of its own rows, all other monomials
+    // divisible by them are cleared by reducers
+    auto rows = reduce<Order>(minimal, {}, minimal, leads, monitor);
+    F->assign(std::make_move_iterator(rows.rbegin()), std::make_move_iterator(rows.rend()));
+    monitor->on_phase_finished(Phase::kAutoReduce);
+}
+
+template<class Order>
+std::vector<BooleanPolynomial<Order>> BooleanAlgorithm::eliminate(const std::vector<BooleanPolynomial<Order>>& rows) {
+    NoStatistics statistics;
+    return eliminate<Order>(rows, &statistics);
+}
+
+template<class Order, class Monitor>
+std::vector<BooleanPolynomial<Order>> BooleanAlgorithm::eliminate(const std::vector<BooleanPolynomial<Order>>& rows,
+                                                                  Monitor* monitor) {
+    return eliminate<Order>({}, rows, monitor);
+}
+
+template<class Order, class Monitor>
+std::vector<BooleanPolynomial<Order>> BooleanAlgorithm::eliminate(const std::vector<BooleanPolynomial<Order>>& reducers,
+                                                                  const std::vector<BooleanPolynomial<Order>>& rows,
+                                                                  Monitor* monitor) {
+    monitor->on_phase_started(Phase::kReduce);
+    std::vector<BooleanMonomial> columns;
+    std::unordered_map<BooleanMonomial, size_t, hash<BooleanMonomial>> column_indices;
+    for (const auto* polynomials : {&reducers, &rows}) {
+        for (const auto& polynomial : *polynomials) {
+            for (const auto& monomial : polynomial) {
+                if (column_indices.emplace(monomial, 0).second) {
+                    columns.push_back(monomial);
+                }
+            }
+        }
+    }
+    std::sort(columns.begin(), columns.end(), [](const auto& a, const auto& b) { return BooleanOrder<Order>()(b, a); });
+    for (size_t i = 0; i < columns.size(); ++i) {
+        column_indices[columns[i]] = i;
+    }
+
+    const size_t word_count = (columns.size() + BooleanMonomial::kWordBits - 1) / BooleanMonomial::kWordBits;
+    auto to_bits = [&](const BooleanPolynomial<Order>& polynomial) {
+        std::vector<Word> bits(word_count, 0);
+        for (const auto& monomial : polynomial) {
+            auto column = column_indices[monomial];
+            bits[column / BooleanMonomial::kWordBits] |= Word(1) << (column % BooleanMonomial::kWordBits);
+        }
+        return bits;
+    };
+    // reducer_of_column[c] is the reducer with leading monomial columns[c], if any
+    constexpr size_t kNone = SIZE_MAX;
+    std::vector<size_t> reducer_of_column(columns.size(), kNone);
+    std::vector<std::vector<Word>> reducer_matrix;
+    reducer_matrix.reserve(reducers.size());
+    for (const auto& reducer : reducers) {
+        reducer_of_column[column_indices[reducer.get_leading_monomial()]] = reducer_matrix.size();
+        reducer_matrix.push_back(to_bits(reducer));
+    }
+    std::vector<std::vector<Word>> matrix;
+    matrix.reserve(rows.size());
+    for (const auto& row : rows) {
+        matrix.push_back(to_bits(row));
+    }
+
+    // Gauss-Jordan on the rows, where the columns with a reducer are cleared by it. Rows [0, rank)
+    // are pivots, a pivot row has no bits before its pivot, so words before it are skipped.
+    size_t rank = 0;
+    for (size_t column = 0; column < columns.size(); ++column) {
+        size_t word = column / BooleanMonomial::kWordBits;
+        Word bit = Word(1) << (column % BooleanMonomial::kWordBits);
+        const std::vector<Word>* pivot_row = nullptr;
+        size_t pivot = kNone;
+        if (reducer_of_column[column] != kNone) {
+            pivot_row = &reducer_matrix[reducer_of_column[column]];
+        } else {
+            pivot = rank;
+            while (pivot < matrix.size() && (matrix[pivot][word] & bit) == 0) {
+                ++pivot;
+            }
+            if (pivot == matrix.size()) {
+                continue;
+            }
+            std::swap(matrix[rank], matrix[pivot]);
+            pivot = rank++;
+            pivot_row = &matrix[pivot];
+        }
+        for (size_t i = 0; i < matrix.size(); ++i) {
+            if (i != pivot && (matrix[i][word] & bit) != 0) {
+                monitor->on_reduction_step();
+                for (size_t j = word; j < word_count; ++j) {
+                    matrix[i][j] ^= (*pivot_row)[j];
+                }
+            }
+        }
+    }
+
+    std::vector<BooleanPolynomial<Order>> result;
+    result.reserve(rank);
+    for (size_t i = 0; i < rank; ++i) {
+        std::vector<BooleanMonomial> terms;
+        for (size_t j = 0; j < word_count; ++j) {
+            for (auto word = matrix[i][j]; word != 0; word &= word - 1) {
+                terms.push_back(columns[j * BooleanMonomial::kWordBits + __builtin_ctzll(word)]);
+            }
+        }
+        result.emplace_back(std::move(terms));
+    }
+    monitor->on_phase_finished(Phase::kReduce);
+    return result;
+}
+
+template<class Order, class Monitor>
+void BooleanAlgorithm::insert(BooleanPolynomial<Order> h, std::vector<BooleanPolynomial<Order>>* basis,
+                              std::vector<bool>* is_active, std::vector<Pair>* pairs, Monitor* monitor) {
+    const auto lead = h.get_leading_monomial();
+    size_t index = basis->size();
+
+    // an old pair is not needed if lead divides its lcm and the lcms of lead with both elements
+    // differ from it (the chain criterion)
+    auto is_needed = [&](const Pair& pair) {
+        if (pair.second == kFieldEquation || !pair.lcm.is_divisible_by(lead)) {
+            return true;
+        }
+        return (*basis)[pair.first].get_leading_monomial() * lead == pair.lcm ||
+               (*basis)[pair.second].get_leading_monomial() * lead == pair.lcm;
+    };
+    auto needed_end = std::partition(pairs->begin(), pairs->end(), is_needed);
+    for (auto it = needed_end; it != pairs->end(); ++it) {
+        monitor->on_pair_eliminated(PairCriterion::kFiltered);
+    }
+    pairs->erase(needed_end, pairs->end());
+
+    // a new pair is dropped if its lcm is divisible by the lcm of a later pair or of an earlier
+    // kept one, unless the leading monomials are coprime; then those are dropped too
+    // (Buchberger's first criterion)
+    std::vector<Pair> candidates;
+    std::vector<bool> is_coprime;
+    for (size_t i = 0; i < index; ++i) {
+        if ((*is_active)[i]) {
+            const auto& other_lead = (*basis)[i].get_leading_monomial();
+            auto lcm = lead * other_lead;
+            auto degree = lcm.get_degree();
+            candidates.push_back({i, index, 0, std::move(lcm), degree});
+            is_coprime.push_back(lead.is_coprime_with(other_lead));
+        }
+    }
+    std::vector<bool> is_kept(candidates.size(), true);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (is_coprime[i]) {
+            continue;
+        }
+        for (size_t j = 0; j < candidates.size(); ++j) {
+            if (j != i && (j > i || is_kept[j]) && candidates[i].lcm.is_divisible_by(candidates[j].lcm)) {
+                is_kept[i] = false;
+                break;
+            }
+        }
+    }
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (is_kept[i] && !is_coprime[i]) {
+            pairs->push_back(std::move(candidates[i]));
+            monitor->on_pair_created();
+        } else {
+            monitor->on_pair_eliminated(PairCriterion::kFiltered);
+        }
+    }
+    // pairs with the field equations of the variables that are not in lead are coprime
+    for (auto variable : lead.get_variables()) {
+        pairs->push_back({index, kFieldEquation, variable, lead, lead.get_degree()});
+        monitor->on_pair_created();
+    }
+
+    for (size_t i = 0; i < index; ++i) {
+        if ((*is_active)[i] && (*basis)[i].get_leading_monomial().is_divisible_by(lead)) {
+            (*is_active)[i] = false;
+        }
+    }
+    basis->push_back(std::move(h));
+    is_active->push_back(true);
+}
+
+template<class Order, class Monitor>
+std::vector<BooleanPolynomial<Order>> BooleanAlgorithm::reduce(const std::vector<BooleanPolynomial<Order>>& basis,
+                                                               std::vector<BooleanPolynomial<Order>> reducers,
+                                                               const std::vector<BooleanPolynomial<Order>>& rows,
+                                                               const std::unordered_set<BooleanMonomial, hash<BooleanMonomial>>& kept,
+                                                               Monitor* monitor) {
+    monitor->on_phase_started(Phase::kGetS);
+    std::unordered_set<BooleanMonomial, hash<BooleanMonomial>> covered = kept;
+    for (const auto& reducer : reducers) {
+        covered.insert(reducer.get_leading_monomial());
+    }
+    std::unordered_set<BooleanMonomial, hash<BooleanMonomial>> seen;
+    std::vector<BooleanMonomial> pending;
+    auto add_monomials = [&](const BooleanPolynomial<Order>& polynomial) {
+        for (const auto& monomial : polynomial) {
+            if (seen.insert(monomial).second) {
+                pending.push_back(monomial);
+            }
+        }
+    };
+    for (const auto& reducer : reducers) {
+        add_monomials(reducer);
+    }
+    for (const auto& row : rows) {
+        add_monomials(row);
+    }
+    while (!pending.empty()) {
+        auto monomial = std::move(pending.back());
+        pending.pop_back();
+        if (covered.count(monomial)) {
+            continue;
+        }
+        for (const auto& g : basis) {
+            const auto& lead = g.get_leading_monomial();
+            if (monomial.is_divisible_by(lead)) {
+                // the multiplier has no variables of lead, so the leading monomial stays monomial
+                reducers.push_back(g * (monomial / lead));
+                assert(reducers.back().get_leading_monomial() == monomial);
+                add_monomials(reducers.back());
+                covered.insert(std::move(monomial));
+                break;
+            }
+        }
+    }
+    monitor->on_phase_finished(Phase::kGetS);
+    return eliminate<Order>(reducers, rows, monitor);
+}
+
+template<class Order>
+bool BooleanAlgorithm::is_reducible(const BooleanMonomial& monomial, const std::vector<BooleanPolynomial<Order>>& basis) {
+    for (const auto& g : basis) {
+        if (monomial.is_divisible_by(g.get_leading_monomial())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // grobner
+
+#endif  // GROBNER_BOOLEAN_ALGORITHM_H_
@@ -0,0 +1,264 @@
+#ifndef GROBNER_BOOLEAN_MONOMIAL_H_
+#define GROBNER_BOOLEAN_MONOMIAL_H_
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "hashes.h"
+#include "monomial_order.h"
+
+namespace grobner {
+
+// Monomial of the boolean ring GF(2)[x_1, ..., x_n] / (x_i^2 - x_i): the set of its variables as
+// a bitset, 64 variables per word. The product is the union (x * x = x), so it never overflows.
+class BooleanMonomial {
+  public:
+    using Word = uint64_t;
+    static constexpr size_t kWordBits = 64;
+
+    BooleanMonomial();
+    // indices of the variables, a is 0
+    BooleanMonomial(std::initializer_list<size_t> variables);
+    // variables a..z, for example: abd; powers are ignored since x^k = x
+    BooleanMonomial(std::string s);
+
+    size_t get_degree() const;
+    bool has_variable(size_t i) const;
+    void set_variable(size_t i);
+    std::vector<size_t> get_variables() const;
+
+    bool is_divisible_by(const BooleanMonomial& other) const;
+    // no common variables
+    bool is_coprime_with(const BooleanMonomial& other) const;
+
+    size_t word_count() const;
+    Word get_word(size_t i) const;
+
+    friend BooleanMonomial& operator *= (BooleanMonomial& first, const BooleanMonomial& second) {
+        if (first.words_.size() < second.words_.size()) {
+            first.words_.resize(second.words_.size(), 0);
+        }
+        for (size_t i = 0; i < second.words_.size(); ++i) {
+            first.words_[i] |= second.words_[i];
+        }
+        return first;
+    }
+    friend BooleanMonomial operator * (const BooleanMonomial& first, const BooleanMonomial& second) {
+        auto result = first;
+        result *= second;
+        return result;
+    }
+
+    // removes the variables of second, the quotient if first is divisible by second
+    friend BooleanMonomial& operator /= (BooleanMonomial& first, const BooleanMonomial& second) {
+        for (size_t i = 0; i < std::min(first.words_.size(), second.words_.size()); ++i) {
+            first.words_[i] &= ~second.words_[i];
+        }
+        first.remove_last_zeros();
+        return first;
+    }
+    friend BooleanMonomial operator / (const BooleanMonomial& first, const BooleanMonomial& second) {
+        auto result = first;
+        result /= second;
+        return result;
+    }
+
+    friend bool operator == (const BooleanMonomial& first, const BooleanMonomial& second) {
+        return first.words_ == second.words_;
+    }
+    friend bool operator != (const BooleanMonomial& first, const BooleanMonomial& second) {
+        return !(first == second);
+    }
+
+    friend std::ostream& operator << (std::ostream& out, const BooleanMonomial& monomial);
+
+  private:
+    std::vector<Word> words_;
+
+    void remove_last_zeros();
+};
+
+template<>
+struct hash<grobner::BooleanMonomial> {
+    size_t operator()(const grobner::BooleanMonomial& monomial) const;
+};
+
+// Comparison of boolean monomials consistent with Order on Monomial with degrees 0 and 1.
+// Defined for DegOrder, LexOrder, RevLexOrder and their OrderSum.
+template<class Order>
+struct BooleanOrder {
+    static int cmp(const BooleanMonomial& first, const BooleanMonomial& second);
+
+    bool operator()(const BooleanMonomial& first, const BooleanMonomial& second) const;
+};
+
+template<class FirstOrder, class SecondOrder>
+struct BooleanOrder<OrderSum<FirstOrder, SecondOrder>> {
+    static int cmp(const BooleanMonomial& first, const BooleanMonomial& second);
+
+    bool operator()(const BooleanMonomial& first, const BooleanMonomial& second) const;
+};
+
+
+inline BooleanMonomial::BooleanMonomial() {}
+
+inline BooleanMonomial::BooleanMonomial(std::initializer_list<size_t> variables) {
+    for (auto i : variables) {
+        set_variable(i);
+    }
+}
+
+inline BooleanMonomial::BooleanMonomial(std::string s) {
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (s[i] >= 'a' && s[i] <= 'z') {
+            set_variable(s[i] - 'a');
+        } else if (s[i] == '^') {
+            while (i + 1 < s.size() && std::isdigit(s[i + 1])) {
+                ++i;
+            }
+        }
+    }
+}
+
+inline size_t BooleanMonomial::get_degree() const {
+    size_t degree = 0;
+    for (auto word : words_) {
+        degree += __builtin_popcountll(word);
+    }
+    return degree;
+}
+
+inline bool BooleanMonomial::has_variable(size_t i) const {
+    return (get_word(i / kWordBits) >> (i % kWordBits)) & 1;
+}
+
+inline void BooleanMonomial::set_variable(size_t i) {
+    if (words_.size() <= i / kWordBits) {
+        words_.resize(i / kWordBits + 1, 0);
+    }
+    words_[i / kWordBits] |= Word(1) << (i % kWordBits);
+}
+
+inline std::vector<size_t> BooleanMonomial::get_variables() const {
+    std::vector<size_t> variables;
+    for (size_t i = 0; i < words_.size(); ++i) {
+        for (auto word = words_[i]; word != 0; word &= word - 1) {
+            variables.push_back(i * kWordBits + __builtin_ctzll(word));
+        }
+    }
+    return variables;
+}
+
+inline bool BooleanMonomial::is_divisible_by(const BooleanMonomial& other) const {
+    for (size_t i = 0; i < other.words_.size(); ++i) {
+        if ((other.words_[i] & ~get_word(i)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool BooleanMonomial::is_coprime_with(const BooleanMonomial& other) const {
+    for (size_t i = 0; i < std::min(words_.size(), other.words_.size()); ++i) {
+        if ((words_[i] & other.words_[i]) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline size_t BooleanMonomial::word_count() const {
+    return words_.size();
+}
+
+inline BooleanMonomial::Word BooleanMonomial::get_word(size_t i) const {
+    return i < words_.size() ? words_[i] : 0;
+}
+
+inline void BooleanMonomial::remove_last_zeros() {
+    while (!words_.empty() && words_.back() == 0) {
+        words_.pop_back();
+    }
+}
+
+inline std::ostream& operator << (std::ostream& out, const BooleanMonomial& monomial) {
+    auto variables = monomial.get_variables();
+    bool use_alphabet = variables.empty() || variables.back() < 26;  // same as for Monomial
+    for (auto i : variables) {
+        if (use_alphabet) {
+            out << (char)('a' + i);
+        } else {
+            out << 'x' << (i + 1);
+        }
+    }
+    return out;
+}
+
+
+template<>
+inline int BooleanOrder<DegOrder>::cmp(const BooleanMonomial& first, const BooleanMonomial& second) {
+    auto first_degree = first.get_degree();
+    auto second_degree = second.get_degree();
+    if (first_degree < second_degree) {
+        return -1;
+    } else if (first_degree == second_degree) {
+        return 0;
+    } else {
+        return 1;
+    }
+}
+
+// the first differing variable decides: LexOrder prefers the monomial that has it,
+// RevLexOrder the one that doesn't
+template<>
+inline int BooleanOrder<LexOrder>::cmp(const BooleanMonomial& first, const BooleanMonomial& second) {
+    for (size_t i = 0; i < std::max(first.word_count(), second.word_count()); ++i) {
+        auto difference = first.get_word(i) ^ second.get_word(i);
+        if (difference != 0) {
+            return (first.get_word(i) >> __builtin_ctzll(difference)) & 1 ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+template<>
+inline int BooleanOrder<RevLexOrder>::cmp(const BooleanMonomial& first, const BooleanMonomial& second) {
+    return BooleanOrder<LexOrder>::cmp(second, first);
+}
+
+template<class Order>
+bool BooleanOrder<Order>::operator()(const BooleanMonomial& first, const BooleanMonomial& second) const {
+    return cmp(first, second) < 0;
+}
+
+template<class FirstOrder, class SecondOrder>
+int BooleanOrder<OrderSum<FirstOrder, SecondOrder>>::cmp(const BooleanMonomial& first, const BooleanMonomial& second) {
+    int cmp_first = BooleanOrder<FirstOrder>::cmp(first, second);
+    if (cmp_first == 0) {
+        return BooleanOrder<SecondOrder>::cmp(first, second);
+    }
+    return cmp_first;
+}
+
+template<class FirstOrder, class SecondOrder>
+bool BooleanOrder<OrderSum<FirstOrder, SecondOrder>>::operator()(const BooleanMonomial& first,
+                                                                const BooleanMonomial& second) const {
+    return cmp(first, second) < 0;
+}
+
+inline size_t hash<grobner::BooleanMonomial>::operator()(const grobner::BooleanMonomial& monomial) const {
+    size_t result = 0;
+    for (size_t i = 0; i < monomial.word_count(); ++i) {
+        result = result * 0x9e3779b97f4a7c15ull + std::hash<grobner::BooleanMonomial::Word>()(monomial.get_word(i));
+    }
+    return result;
+}
+
+}  // grobner
+
+#endif  // GROBNER_BOOLEAN_MONOMIAL_H_
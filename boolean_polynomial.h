@@ -0,0 +1,212 @@
+#ifndef GROBNER_BOOLEAN_POLYNOMIAL_H_
+#define GROBNER_BOOLEAN_POLYNOMIAL_H_
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "boolean_monomial.h"
+
+namespace grobner {
+
+// Polynomial of the boolean ring: coefficients are implicit (every present term has coefficient 1),
+// terms are kept sorted by Order from the largest, so the leading monomial is the first one and
+// the sum is the symmetric difference of two sorted arrays, computed by a merge.
+template<class Order>
+class BooleanPolynomial {
+  public:
+    using const_iterator = typename std::vector<BooleanMonomial>::const_iterator;
+
+    BooleanPolynomial();
+    BooleanPolynomial(BooleanMonomial monomial);
+    // monomials separated by '+', "1" is the unit, for example: ab+c+1; equal terms cancel
+    BooleanPolynomial(std::string s);
+    BooleanPolynomial(const char* c);
+    // terms in any order, equal terms cancel in pairs
+    explicit BooleanPolynomial(std::vector<BooleanMonomial> terms);
+
+    bool is_zero() const;
+    size_t size() const;
+    const BooleanMonomial& get_leading_monomial() const;
+    // sorted by Order from the largest
+    const std::vector<BooleanMonomial>& get_terms() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    friend BooleanPolynomial& operator += (BooleanPolynomial& first, const BooleanPolynomial& second) {
+        first.terms_ = get_symmetric_difference(first.terms_, second.terms_);
+        return first;
+    }
+    friend BooleanPolynomial operator + (const BooleanPolynomial& first, const BooleanPolynomial& second) {
+        BooleanPolynomial result;
+        result.terms_ = get_symmetric_difference(first.terms_, second.terms_);
+        return result;
+    }
+
+    // x * x = x, so the terms are sorted again and those that became equal cancel
+    friend BooleanPolynomial operator * (const BooleanPolynomial& first, const BooleanMonomial& second) {
+        std::vector<BooleanMonomial> terms;
+        terms.reserve(first.size());
+        for (const auto& term : first.terms_) {
+            terms.push_back(term * second);
+        }
+        return BooleanPolynomial(std::move(terms));
+    }
+    friend BooleanPolynomial& operator *= (BooleanPolynomial& first, const BooleanMonomial& second) {
+        first = first * second;
+        return first;
+    }
+    friend BooleanPolynomial operator * (const BooleanPolynomial& first, const BooleanPolynomial& second) {
+        std::vector<BooleanMonomial> terms;
+        terms.reserve(first.size() * second.size());
+        for (const auto& a : first.terms_) {
+            for (const auto& b : second.terms_) {
+                terms.push_back(a * b);
+            }
+        }
+        return BooleanPolynomial(std::move(terms));
+    }
+    friend BooleanPolynomial& operator *= (BooleanPolynomial& first, const BooleanPolynomial& second) {
+        first = first * second;
+        return first;
+    }
+
+    friend bool operator == (const BooleanPolynomial& first, const BooleanPolynomial& second) {
+        return first.terms_ == second.terms_;
+    }
+    friend bool operator != (const BooleanPolynomial& first, const BooleanPolynomial& second) {
+        return !(first == second);
+    }
+
+    template<class OtherOrder>
+    friend std::ostream& operator << (std::ostream& out, const BooleanPolynomial<OtherOrder>& polynomial);
+
+  private:
+    // merge of two sorted arrays without the terms present in both
+    static std::vector<BooleanMonomial> get_symmetric_difference(const std::vector<BooleanMonomial>& first,
+                                                                 const std::vector<BooleanMonomial>& second);
+
+    std::vector<BooleanMonomial> terms_;
+};
+
+
+template<class Order>
+BooleanPolynomial<Order>::BooleanPolynomial() {}
+
+template<class Order>
+BooleanPolynomial<Order>::BooleanPolynomial(BooleanMonomial monomial) {
+    terms_.push_back(std::move(monomial));
+}
+
+template<class Order>
+BooleanPolynomial<Order>::BooleanPolynomial(std::string s) {
+    std::vector<BooleanMonomial> terms;
+    size_t start = 0;
+    while (start <= s.size()) {
+        auto end = std::min(s.find('+', start), s.size());
+        auto term = s.substr(start, end - start);
+        term.erase(std::remove(term.begin(), term.end(), ' '), term.end());
+        if (!term.empty() && term != "0") {
+            terms.emplace_back(term);
+        }
+        start = end + 1;
+    }
+    *this = BooleanPolynomial(std::move(terms));
+}
+
+template<class Order>
+BooleanPolynomial<Order>::BooleanPolynomial(const char* c) : BooleanPolynomial(std::string(c)) {}
+
+template<class Order>
+BooleanPolynomial<Order>::BooleanPolynomial(std::vector<BooleanMonomial> terms) {
+    std::sort(terms.begin(), terms.end(), [](const auto& a, const auto& b) { return BooleanOrder<Order>()(b, a); });
+    for (size_t i = 0; i < terms.size(); ) {
+        size_t j = i;
+        while (j < terms.size() && terms[j] == terms[i]) {
+            ++j;
+        }
+        if ((j - i) % 2 == 1) {
+            terms_.push_back(std::move(terms[i]));
+        }
+        i = j;
+    }
+}
+
+template<class Order>
+bool BooleanPolynomial<Order>::is_zero() const {
+    return terms_.empty();
+}
+
+template<class Order>
+size_t BooleanPolynomial<Order>::size() const {
+    return terms_.size();
+}
+
+template<class Order>
+const BooleanMonomial& BooleanPolynomial<Order>::get_leading_monomial() const {
+    assert(!is_zero());
+    return terms_.front();
+}
+
+template<class Order>
+const std::vector<BooleanMonomial>& BooleanPolynomial<Order>::get_terms() const {
+    return terms_;
+}
+
+template<class Order>
+typename BooleanPolynomial<Order>::const_iterator BooleanPolynomial<Order>::begin() const {
+    return terms_.begin();
+}
+
+template<class Order>
+typename BooleanPolynomial<Order>::const_iterator BooleanPolynomial<Order>::end() const {
+    return terms_.end();
+}
+
+template<class Order>
+std::vector<BooleanMonomial> BooleanPolynomial<Order>::get_symmetric_difference(
+        const std::vector<BooleanMonomial>& first, const std::vector<BooleanMonomial>& second) {
+    std::vector<BooleanMonomial> result;
+    result.reserve(first.size() + second.size());
+    size_t i = 0, j = 0;
+    while (i < first.size() && j < second.size()) {
+        int cmp = BooleanOrder<Order>::cmp(first[i], second[j]);
+        if (cmp > 0) {
+            result.push_back(first[i++]);
+        } else if (cmp < 0) {
+            result.push_back(second[j++]);
+        } else {
+            ++i;
+            ++j;
+        }
+    }
+    result.insert(result.end(), first.begin() + i, first.end());
+    result.insert(result.end(), second.begin() + j, second.end());
+    return result;
+}
+
+template<class Order>
+std::ostream& operator << (std::ostream& out, const BooleanPolynomial<Order>& polynomial) {
+    if (polynomial.is_zero()) {
+        return out << '0';
+    }
+    for (size_t i = 0; i < polynomial.size(); ++i) {
+        if (i != 0) {
+            out << '+';
+        }
+        if (polynomial.terms_[i] == BooleanMonomial()) {
+            out << '1';
+        } else {
+            out << polynomial.terms_[i];
+        }
+    }
+    return out;
+}
+
+}  // grobner
+
+#endif  // GROBNER_BOOLEAN_POLYNOMIAL_H_
@@ -0,0 +1,196 @@
+#ifndef GROBNER_CHECKPOINT_H_
+#define GROBNER_CHECKPOINT_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "algorithm.h"
+#include "polynomial_set.h"
+#include "serialization.h"
+#include "statistics.h"
+
+namespace grobner {
+
+// State of extend_to_grobners_basis between two iterations of the main loop.
+// Resuming continues with Algorithm::continue_grobners_basis, and since the final
+// auto-reduced basis is unique, the result is the same as without interruption.
+// The file records the order and the field (see OrderName and FieldName, for DynModular with
+// the modulus), a checkpoint of another field is not loaded and one of another order is not resumed.
+template<class ValueType>
+class Checkpoint {
+  public:
+    PolynomialSet<ValueType> basis;
+    PolynomialSet<ValueType> set_of_s;
+    bool has_statistics = false;
+    Statistics statistics;
+    // OrderName of the computation
+    std::string order;
+
+    // writes to a temporary file first, so that a crash during saving keeps the previous checkpoint
+    template<class Order>
+    static void save(const std::string& path, const PolynomialSet<ValueType>& basis,
+                     const PolynomialSet<ValueType>& set_of_s, const Statistics* statistics = nullptr);
+    // throws std::runtime_error if the file is missing or malformed or was written for another field
+    static Checkpoint load(const std::string& path);
+
+    // finishes the computation, the basis is moved to F; throws std::runtime_error if the
+    // checkpoint was written for another order
+    template<class Order, class Monitor>
+    void resume(PolynomialSet<ValueType>* F, Monitor* monitor);
+    template<class Order>
+    void resume(PolynomialSet<ValueType>* F);
+};
+
+// Monitor that saves a checkpoint every iteration_interval iterations and/or every
+// seconds_interval seconds (0 disables the corresponding trigger). Order is the order of the
+// computation, it is written into the checkpoint.
+template<class Order>
+class Checkpointer : public NoStatistics {
+  public:
+    // if statistics is not null, it is saved too
+    Checkpointer(std::string path, size_t iteration_interval, double seconds_interval = 0,
+                 const Statistics* statistics = nullptr);
+
+    template<class ValueType>
+    void on_iteration_finished(const PolynomialSet<ValueType>& F, const PolynomialSet<ValueType>& set_of_s);
+
+    // forces a checkpoint after the current iteration, safe to call from a signal handler
+    void request();
+
+    size_t get_checkpoint_count() const;
+
+  private:
+    std::string path_;
+    size_t iteration_interval_;
+    double seconds_interval_;
+    const Statistics* statistics_;
+
+    size_t iterations_since_checkpoint_ = 0;
+    std::chrono::steady_clock::time_point last_checkpoint_;
+    size_t checkpoint_count_ = 0;
+    std::atomic<bool> requested_{false};
+};
+
+
+template<class ValueType>
+template<class Order>
+void Checkpoint<ValueType>::save(const std::string& path, const PolynomialSet<ValueType>& basis,
+                                 const PolynomialSet<ValueType>& set_of_s, const Statistics* statistics) {
+    std::string temporary_path = path + ".tmp";
+    {
+        std::ofstream out(temporary_path);
+        out << "grobner_checkpoint 3\n";
+        out << "order " << OrderName<Order>::get() << " field " << FieldName<ValueType>::get() << '\n';
+        out << "basis ";
+        Serializer<PolynomialSet<ValueType>>::write(out, basis);
+        out << "set_of_s ";
+        Serializer<PolynomialSet<ValueType>>::write(out, set_of_s);
+        out << "statistics " << (statistics != nullptr) << '\n';
+        if (statistics != nullptr) {
+            Serializer<Statistics>::write(out, *statistics);
+        }
+        out << "end\n";
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("can't write checkpoint " + temporary_path);
+        }
+    }
+    if (std::rename(temporary_path.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("can't rename checkpoint to " + path);
+    }
+}
+
+template<class ValueType>
+Checkpoint<ValueType> Checkpoint<ValueType>::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("can't open checkpoint " + path);
+    }
+    Checkpoint checkpoint;
+    expect_token(in, "grobner_checkpoint");
+    // version 2: pairs_eliminated has the kFiltered counter, version 3: the order and the field
+    expect_token(in, "3");
+    expect_token(in, "order");
+    checkpoint.order = read_checked<std::string>(in);
+    expect_token(in, "field");
+    auto field = read_checked<std::string>(in);
+    if (field != FieldName<ValueType>::get()) {
+        throw std::runtime_error("checkpoint " + path + " is written for field " + field + ", not " +
+                                 FieldName<ValueType>::get());
+    }
+    expect_token(in, "basis");
+    checkpoint.basis = Serializer<PolynomialSet<ValueType>>::read(in);
+    expect_token(in, "set_of_s");
+    checkpoint.set_of_s = Serializer<PolynomialSet<ValueType>>::read(in);
+    expect_token(in, "statistics");
+    checkpoint.has_statistics = read_checked<bool>(in);
+    if (checkpoint.has_statistics) {
+        checkpoint.statistics = Serializer<Statistics>::read(in);
+    }
+    expect_token(in, "end");
+    return checkpoint;
+}
+
+template<class ValueType>
+template<class Order, class Monitor>
+void Checkpoint<ValueType>::resume(PolynomialSet<ValueType>* F, Monitor* monitor) {
+    if (order != OrderName<Order>::get()) {
+        throw std::runtime_error("checkpoint is written for order " + order + ", not " + OrderName<Order>::get());
+    }
+    *F = std::move(basis);
+    Algorithm::continue_grobners_basis<Order>(F, &set_of_s, monitor);
+}
+
+template<class ValueType>
+template<class Order>
+void Checkpoint<ValueType>::resume(PolynomialSet<ValueType>* F) {
+    NoStatistics statistics;
+    resume<Order>(F, &statistics);
+}
+
+
+template<class Order>
+Checkpointer<Order>::Checkpointer(std::string path, size_t iteration_interval, double seconds_interval,
+                                  const Statistics* statistics) :
+    path_(std::move(path)),
+    iteration_interval_(iteration_interval),
+    seconds_interval_(seconds_interval),
+    statistics_(statistics),
+    last_checkpoint_(std::chrono::steady_clock::now()) {
+}
+
+template<class Order>
+template<class ValueType>
+void Checkpointer<Order>::on_iteration_finished(const PolynomialSet<ValueType>& F, const PolynomialSet<ValueType>& set_of_s) {
+    ++iterations_since_checkpoint_;
+    auto now = std::chrono::steady_clock::now();
+    bool is_due = requested_.exchange(false) ||
+                  (iteration_interval_ != 0 && iterations_since_checkpoint_ >= iteration_interval_) ||
+                  (seconds_interval_ != 0 &&
+                   std::chrono::duration<double>(now - last_checkpoint_).count() >= seconds_interval_);
+    if (!is_due) {
+        return;
+    }
+    Checkpoint<ValueType>::template save<Order>(path_, F, set_of_s, statistics_);
+    iterations_since_checkpoint_ = 0;
+    last_checkpoint_ = now;
+    ++checkpoint_count_;
+}
+
+template<class Order>
+void Checkpointer<Order>::request() {
+    requested_ = true;
+}
+
+template<class Order>
+size_t Checkpointer<Order>::get_checkpoint_count() const {
+    return checkpoint_count_;
+}
+
+}  // grobner
+
+#endif  // GROBNER_CHECKPOINT_H_
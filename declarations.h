@@ -8,12 +8,16 @@ class Monomial;
 template<auto P>
 class Modular;
 
-template<class ValueType>
+// MonomialType is Monomial or SparseMonomial
+template<class ValueType, class MonomialType = Monomial>
 class Polynomial;
 
-template<class ValueType>
+template<class ValueType, class MonomialType = Monomial>
 class PolynomialSet;
 
+template<class ValueType, class MonomialType = Monomial>
+class PolynomialBasis;
+
 }  // grobner
 
 #endif  // GROBNER_DECLARATIONS_H_
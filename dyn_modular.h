@@ -0,0 +1,259 @@
+#ifndef GROBNER_DYN_MODULAR_H_
+#define GROBNER_DYN_MODULAR_H_
+
+#include <cassert>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "hashes.h"
+#include "serialization.h"
+#include "statistics.h"
+
+namespace grobner {
+
+// Z/pZ for a prime p chosen at run time, with the constant for Barrett reduction precomputed,
+// so that multiplication doesn't need a division instruction
+class PrimeField {
+  public:
+    using ValueType = long long;
+
+    // throws std::invalid_argument unless 2 <= modulus < 2^32, primality is not checked
+    explicit PrimeField(ValueType modulus);
+
+    ValueType get_modulus() const;
+    // value mod p, requires value < p^2
+    unsigned long long reduce(unsigned long long value) const;
+
+  private:
+    unsigned long long modulus_;
+    // floor((2^64 - 1) / modulus)
+    unsigned long long barrett_multiplier_;
+};
+
+// Same interface as Modular<P>, but the modulus is taken from the PrimeField of the innermost
+// DynModular::FieldScope of the current thread. Values don't store the field, so values of
+// different fields must not be mixed; every value except zero must be created inside a scope.
+class DynModular {
+  public:
+    using ValueType = PrimeField::ValueType;
+
+    // makes field current for the thread until destruction, scopes may be nested
+    class FieldScope {
+      public:
+        explicit FieldScope(const PrimeField& field);
+        ~FieldScope();
+
+        FieldScope(const FieldScope&) = delete;
+        FieldScope& operator = (const FieldScope&) = delete;
+
+      private:
+        const PrimeField* previous_field_;
+    };
+
+    DynModular(ValueType value = 0);
+
+    static const PrimeField& get_field();
+    static ValueType make_normal(ValueType value);
+
+    DynModular get_pow(ValueType power) const;
+    DynModular get_inverse() const;
+    ValueType get_value() const;
+
+    friend std::ostream& operator << (std::ostream& out, const DynModular& other);
+    friend std::istream& operator >> (std::istream& in, DynModular& other);
+
+    DynModular operator - () const;
+
+    friend DynModular& operator += (DynModular& first, const DynModular& second) {
+        first.value_ += second.value_;
+        if (first.value_ >= get_field().get_modulus()) {
+            first.value_ -= get_field().get_modulus();
+        }
+        return first;
+    }
+    friend DynModular operator + (const DynModular& first, const DynModular& second) {
+        auto result = first;
+        return result += second;
+    }
+    friend DynModular& operator -= (DynModular& first, const DynModular& second) {
+        first.value_ -= second.value_;
+        if (first.value_ < 0) {
+            first.value_ += get_field().get_modulus();
+        }
+        return first;
+    }
+    friend DynModular operator - (const DynModular& first, const DynModular& second) {
+        auto result = first;
+        return result -= second;
+    }
+    friend DynModular& operator *= (DynModular& first, const DynModular& second) {
+        first.value_ = get_field().reduce((unsigned long long)first.value_ * (unsigned long long)second.value_);
+        return first;
+    }
+    friend DynModular operator * (const DynModular& first, const DynModular& second) {
+        auto result = first;
+        return result *= second;
+    }
+    friend DynModular& operator /= (DynModular& first, const DynModular& second) {
+        first *= second.get_inverse();
+        return first;
+    }
+    friend DynModular operator / (const DynModular& first, const DynModular& second) {
+        auto result = first;
+        return result /= second;
+    }
+
+    friend bool operator == (const DynModular& first, const DynModular& second) {
+        return first.value_ == second.value_;
+    }
+    friend bool operator != (const DynModular& first, const DynModular& second) {
+        return !(first == second);
+    }
+
+  private:
+    ValueType value_;
+
+    inline static thread_local const PrimeField* field_ = nullptr;
+};
+
+template<>
+struct CoefficientSize<DynModular> {
+    static size_t get_bits(const DynModular& value) {
+        return CoefficientSize<DynModular::ValueType>::get_bits(value.get_value());
+    }
+};
+
+template<>
+struct hash<grobner::DynModular> {
+    size_t operator()(const grobner::DynModular& modular) const;
+};
+
+// the modulus is not written, reading requires the same field in scope
+template<>
+struct Serializer<DynModular> {
+    static void write(std::ostream& out, const DynModular& value);
+    static DynModular read(std::istream& in);
+};
+
+// the modulus of the current field
+template<>
+struct FieldName<DynModular> {
+    static std::string get() { return "mod" + std::to_string(DynModular::get_field().get_modulus()); }
+};
+
+
+inline PrimeField::PrimeField(ValueType modulus) {
+    if (modulus < 2 || modulus > (ValueType)std::numeric_limits<unsigned int>::max()) {
+        throw std::invalid_argument("PrimeField: modulus must be in [2, 2^32)");
+    }
+    modulus_ = modulus;
+    barrett_multiplier_ = std::numeric_limits<unsigned long long>::max() / modulus_;
+}
+
+inline PrimeField::ValueType PrimeField::get_modulus() const {
+    return modulus_;
+}
+
+inline unsigned long long PrimeField::reduce(unsigned long long value) const {
+    // the estimated quotient is at most one less than the real one, so the remainder is below 2p
+    auto quotient = (unsigned long long)(((unsigned __int128)value * barrett_multiplier_) >> 64);
+    auto remainder = value - quotient * modulus_;
+    return remainder >= modulus_ ? remainder - modulus_ : remainder;
+}
+
+
+inline DynModular::FieldScope::FieldScope(const PrimeField& field) : previous_field_(field_) {
+    field_ = &field;
+}
+
+inline DynModular::FieldScope::~FieldScope() {
+    field_ = previous_field_;
+}
+
+
+inline DynModular::DynModular(ValueType value) : value_(value == 0 ? 0 : make_normal(value)) {}
+
+inline const PrimeField& DynModular::get_field() {
+    assert(field_ != nullptr);
+    return *field_;
+}
+
+inline DynModular::ValueType DynModular::make_normal(ValueType value) {
+    value %= get_field().get_modulus();
+    if (value < 0) {
+        value += get_field().get_modulus();
+    }
+    return value;
+}
+
+inline DynModular DynModular::operator - () const {
+    DynModular result;
+    result.value_ = value_ == 0 ? 0 : get_field().get_modulus() - value_;
+    return result;
+}
+
+inline DynModular DynModular::get_pow(ValueType power) const {
+    if (power == 0) {
+        return DynModular(1);
+    } else if (power < 0) {
+        return get_pow(-power).get_inverse();
+    } else {
+        DynModular result = 1;
+        DynModular current_power = *this;
+        while (power > 0) {
+            if (power % 2 == 1) {
+                result *= current_power;
+            }
+            power /= 2;
+            current_power *= current_power;
+        }
+        return result;
+    }
+}
+
+inline DynModular DynModular::get_inverse() const {
+    // extended Euclid, cheaper than the power p - 2 for a modulus that is not known at compile time
+    ValueType a = value_, b = get_field().get_modulus();
+    ValueType x = 1, y = 0;
+    while (b != 0) {
+        ValueType quotient = a / b;
+        a -= quotient * b;
+        std::swap(a, b);
+        x -= quotient * y;
+        std::swap(x, y);
+    }
+    return DynModular(x);
+}
+
+inline DynModular::ValueType DynModular::get_value() const {
+    return value_;
+}
+
+inline std::ostream& operator << (std::ostream& out, const DynModular& other) {
+    return out << other.value_;
+}
+
+inline std::istream& operator >> (std::istream& in, DynModular& other) {
+    DynModular::ValueType tmp;
+    in >> tmp;
+    other = tmp;
+    return in;
+}
+
+inline size_t hash<grobner::DynModular>::operator()(const grobner::DynModular& modular) const {
+    return hash<grobner::DynModular::ValueType>()(modular.get_value());
+}
+
+inline void Serializer<DynModular>::write(std::ostream& out, const DynModular& value) {
+    out << value.get_value();
+}
+
+inline DynModular Serializer<DynModular>::read(std::istream& in) {
+    return DynModular(read_checked<DynModular::ValueType>(in));
+}
+
+}  // grobner
+
+#endif  // GROBNER_DYN_MODULAR_H_
@@ -0,0 +1,261 @@
+#ifndef GROBNER_FRACTION_FREE_H_
+#define GROBNER_FRACTION_FREE_H_
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/rational.hpp>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "algorithm.h"
+#include "monomial.h"
+#include "pair_filter.h"
+#include "polynomial.h"
+#include "polynomial_basis.h"
+#include "polynomial_set.h"
+#include "statistics.h"
+
+namespace grobner {
+
+// Buchberger algorithm over Q, computed with primitive polynomials over Z: reductions
+// cross-multiply leading coefficients instead of dividing, and the content (gcd of all
+// coefficients) is removed every few reduction steps. Rationals appear only when
+// the final basis is emitted, the result is the same as Algorithm's. The main loop is
+// Algorithm's with FractionFreeReduction below, this class has the arithmetic over Z.
+class FractionFreeAlgorithm {
+  public:
+    using Integer = boost::multiprecision::cpp_int;
+    using Rational = boost::rational<Integer>;
+
+    // content is removed after this many pseudo-reduction steps of a polynomial and after the reduction
+    static constexpr size_t kContentRemovalInterval = 8;
+
+    template<class Order>
+    static void extend_to_grobners_basis(PolynomialSet<Rational>* F);
+    template<class Order, class Monitor>
+    static void extend_to_grobners_basis(PolynomialSet<Rational>* F, Monitor* monitor);
+
+    // f * (lcm of denominators) / content
+    static Polynomial<Integer> to_primitive(const Polynomial<Rational>& f);
+    static Polynomial<Rational> to_rational(const Polynomial<Integer>& f);
+
+    // gcd of all coefficients, non-negative
+    static Integer get_content(const Polynomial<Integer>& f);
+    static void remove_content(Polynomial<Integer>* f);
+    // primitive with positive leading coefficient
+    template<class Order>
+    static void normalize(Polynomial<Integer>* f);
+
+    // pseudo-reduction, g is replaced by c * g - (...) * f with c != 0, so the result
+    // is the normal form over Q up to a constant factor
+    template<class Order, class Monitor>
+    static void reduce_by(const PolynomialSet<Integer>& F, Polynomial<Integer>* g, Monitor* monitor);
+    template<class Order, class Monitor>
+    static void reduce_by(const PolynomialBasis<Integer>& F, Polynomial<Integer>* g, Monitor* monitor);
+
+    template<class Order, class Monitor>
+    static Polynomial<Integer> get_S(const Polynomial<Integer>& f, const Polynomial<Integer>& g, Monitor* monitor);
+
+  private:
+    template<class Order, class Monitor>
+    static bool make_reduction_step(const Polynomial<Integer>& f, const Monomial& f_lead,
+                                    const Integer& f_coefficient, Polynomial<Integer>* g, Monitor* monitor);
+
+    // F is PolynomialSet or PolynomialBasis
+    template<class Order, class Container, class Monitor>
+    static bool make_reduction_step(const Container& F, Polynomial<Integer>* g, Monitor* monitor);
+};
+
+// Reduction policy of Algorithm's main loop (see FullReduction) for primitive polynomials over Z:
+// S-polynomials and reductions cross-multiply, normalize makes the polynomial primitive with a
+// positive leading coefficient instead of monic.
+class FractionFreeReduction {
+  public:
+    using Integer = FractionFreeAlgorithm::Integer;
+
+    template<class Order>
+    void set_basis(const PolynomialSet<Integer>&) {}
+
+    template<class Order, class Monitor>
+    Polynomial<Integer> get_S(const Polynomial<Integer>& f, const Polynomial<Integer>& g, Monitor* monitor);
+
+    template<class Order, class Monitor>
+    void reduce(const PolynomialSet<Integer>& F, Polynomial<Integer>* g, Monitor* monitor);
+
+    template<class Order>
+    Monomial normalize(Polynomial<Integer>* f);
+
+    template<class Order, class Monitor>
+    void reduce_fully(const PolynomialBasis<Integer>& F, Polynomial<Integer>* g, Monitor* monitor);
+};
+
+
+template<class Order>
+void FractionFreeAlgorithm::extend_to_grobners_basis(PolynomialSet<Rational>* F) {
+    NoStatistics statistics;
+    extend_to_grobners_basis<Order>(F, &statistics);
+}
+
+template<class Order, class Monitor>
+void FractionFreeAlgorithm::extend_to_grobners_basis(PolynomialSet<Rational>* F, Monitor* monitor) {
+    PolynomialSet<Integer> G;
+    for (const auto& f : *F) {
+        if (!f.is_zero()) {
+            G.insert(to_primitive(f));
+        }
+    }
+    NoPairFilter filter;
+    FractionFreeReduction reduction;
+    Algorithm::extend_to_grobners_basis<Order>(&G, monitor, &filter, &reduction);
+
+    F->clear();
+    for (const auto& g : G) {
+        F->insert(to_rational(g));
+    }
+    // G is already interreduced, this only makes the polynomials monic
+    Algorithm::auto_reduce<Order>(F, monitor);
+}
+
+inline Polynomial<FractionFreeAlgorithm::Integer> FractionFreeAlgorithm::to_primitive(const Polynomial<Rational>& f) {
+    Integer denominator_lcm = 1;
+    for (const auto& [monomial, coefficient] : f) {
+        denominator_lcm = boost::multiprecision::lcm(denominator_lcm, coefficient.denominator());
+    }
+    Polynomial<Integer> result;
+    for (const auto& [monomial, coefficient] : f) {
+        result.add_monomial(monomial, coefficient.numerator() * (denominator_lcm / coefficient.denominator()));
+    }
+    remove_content(&result);
+    return result;
+}
+
+inline Polynomial<FractionFreeAlgorithm::Rational> FractionFreeAlgorithm::to_rational(const Polynomial<Integer>& f) {
+    Polynomial<Rational> result;
+    for (const auto& [monomial, coefficient] : f) {
+        result.add_monomial(monomial, Rational(coefficient));
+    }
+    return result;
+}
+
+inline FractionFreeAlgorithm::Integer FractionFreeAlgorithm::get_content(const Polynomial<Integer>& f) {
+    Integer content = 0;
+    for (const auto& [monomial, coefficient] : f) {
+        content = boost::multiprecision::gcd(content, coefficient);
+        if (content == 1) {
+            break;
+        }
+    }
+    return abs(content);
+}
+
+inline void FractionFreeAlgorithm::remove_content(Polynomial<Integer>* f) {
+    auto content = get_content(*f);
+    if (content > 1) {
+        *f /= content;
+    }
+}
+
+template<class Order>
+void FractionFreeAlgorithm::normalize(Polynomial<Integer>* f) {
+    if (f->is_zero()) {
+        return;
+    }
+    remove_content(f);
+    if (Algorithm::get_leading_term<Order>(*f).second < 0) {
+        *f *= Integer(-1);
+    }
+}
+
+template<class Order, class Monitor>
+void FractionFreeAlgorithm::reduce_by(const PolynomialSet<Integer>& F, Polynomial<Integer>* g, Monitor* monitor) {
+    monitor->on_phase_started(Phase::kReduce);
+    while (make_reduction_step<Order>(F, g, monitor));
+    normalize<Order>(g);
+    monitor->on_phase_finished(Phase::kReduce);
+}
+
+template<class Order, class Monitor>
+void FractionFreeAlgorithm::reduce_by(const PolynomialBasis<Integer>& F, Polynomial<Integer>* g, Monitor* monitor) {
+    monitor->on_phase_started(Phase::kReduce);
+    while (make_reduction_step<Order>(F, g, monitor));
+    normalize<Order>(g);
+    monitor->on_phase_finished(Phase::kReduce);
+}
+
+template<class Order, class Monitor>
+Polynomial<FractionFreeAlgorithm::Integer> FractionFreeAlgorithm::get_S(const Polynomial<Integer>& f,
+                                                                         const Polynomial<Integer>& g,
+                                                                         Monitor* monitor) {
+    monitor->on_phase_started(Phase::kGetS);
+    auto [f_lead, f_coefficient] = Algorithm::get_leading_term<Order>(f);
+    auto [g_lead, g_coefficient] = Algorithm::get_leading_term<Order>(g);
+    auto lcm = Algorithm::get_LCM(f_lead, g_lead);
+    auto coefficient_gcd = boost::multiprecision::gcd(f_coefficient, g_coefficient);
+    auto result = f * (lcm / f_lead) * Integer(g_coefficient / coefficient_gcd) -
+                  g * (lcm / g_lead) * Integer(f_coefficient / coefficient_gcd);
+    normalize<Order>(&result);
+    monitor->on_phase_finished(Phase::kGetS);
+    return result;
+}
+
+
+template<class Order, class Monitor>
+bool FractionFreeAlgorithm::make_reduction_step(const Polynomial<Integer>& f, const Monomial& f_lead,
+                                                const Integer& f_coefficient, Polynomial<Integer>* g,
+                                                Monitor* monitor) {
+    for (const auto& [monomial, coefficient] : *g) {
+        if (monomial.is_divisible_by(f_lead)) {
+            auto coefficient_gcd = boost::multiprecision::gcd(f_coefficient, coefficient);
+            auto reducer = f * (monomial / f_lead) * Integer(coefficient / coefficient_gcd);
+            *g *= Integer(f_coefficient / coefficient_gcd);
+            *g -= reducer;
+            monitor->on_reduction_step();
+            return true;
+        }
+    }
+    return false;
+}
+
+template<class Order, class Container, class Monitor>
+bool FractionFreeAlgorithm::make_reduction_step(const Container& F, Polynomial<Integer>* g, Monitor* monitor) {
+    bool something_changed = false;
+    size_t steps = 0;
+    for (const auto& f : F) {
+        auto [f_lead, f_coefficient] = Algorithm::get_leading_term<Order>(f);
+        while (make_reduction_step<Order>(f, f_lead, f_coefficient, g, monitor)) {
+            something_changed = true;
+            if (++steps % kContentRemovalInterval == 0) {
+                remove_content(g);
+            }
+        }
+    }
+    return something_changed;
+}
+
+
+template<class Order, class Monitor>
+Polynomial<FractionFreeReduction::Integer> FractionFreeReduction::get_S(const Polynomial<Integer>& f,
+                                                                         const Polynomial<Integer>& g,
+                                                                         Monitor* monitor) {
+    return FractionFreeAlgorithm::get_S<Order>(f, g, monitor);
+}
+
+template<class Order, class Monitor>
+void FractionFreeReduction::reduce(const PolynomialSet<Integer>& F, Polynomial<Integer>* g, Monitor* monitor) {
+    FractionFreeAlgorithm::reduce_by<Order>(F, g, monitor);
+}
+
+template<class Order>
+Monomial FractionFreeReduction::normalize(Polynomial<Integer>* f) {
+    FractionFreeAlgorithm::normalize<Order>(f);
+    return Algorithm::get_leading_term<Order>(*f).first;
+}
+
+template<class Order, class Monitor>
+void FractionFreeReduction::reduce_fully(const PolynomialBasis<Integer>& F, Polynomial<Integer>* g, Monitor* monitor) {
+    FractionFreeAlgorithm::reduce_by<Order>(F, g, monitor);
+}
+
+}  // grobner
+
+#endif  // GROBNER_FRACTION_FREE_H_
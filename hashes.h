@@ -2,11 +2,11 @@
 #define GROBNER_HASHES_H_
 
 #include <boost/rational.hpp>
+#include <functional>
 
 #include "declarations.h"
 #include "modular.h"
 #include "monomial.h"
-#include "polynomial.h"
 
 namespace grobner {
 
@@ -15,9 +15,9 @@ struct hash {
     size_t operator()(const T& value) const;
 };
 
-template<class ValueType>
-struct hash<grobner::Polynomial<ValueType>> {
-    size_t operator()(const grobner::Polynomial<ValueType>& polynomial) const;
+template<class ValueType, class MonomialType>
+struct hash<grobner::Polynomial<ValueType, MonomialType>> {
+    size_t operator()(const grobner::Polynomial<ValueType, MonomialType>& polynomial) const;
 };
 
 template<>
@@ -41,12 +41,13 @@ size_t hash<T>::operator()(const T& value) const {
     return std::hash<T>()(value);
 }
 
-template<class ValueType>
-size_t hash<grobner::Polynomial<ValueType>>::operator()(const grobner::Polynomial<ValueType>& polynomial) const {
+template<class ValueType, class MonomialType>
+size_t hash<grobner::Polynomial<ValueType, MonomialType>>::operator()(
+        const grobner::Polynomial<ValueType, MonomialType>& polynomial) const {
     using Modular = grobner::Modular<1'000'000'007ll>;
     Modular result = 0;
-    for (auto [monomial, coefficient] : polynomial) {
-        result += Modular(hash<grobner::Monomial>()(monomial)).get_value() ^ hash<ValueType>()(coefficient);
+    for (const auto& [monomial, coefficient] : polynomial) {
+        result += Modular(hash<MonomialType>()(monomial)).get_value() ^ hash<ValueType>()(coefficient);
     }
     return result.get_value();
 }
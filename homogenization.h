@@ -0,0 +1,133 @@
+#ifndef GROBNER_HOMOGENIZATION_H_
+#define GROBNER_HOMOGENIZATION_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "algorithm.h"
+#include "monomial.h"
+#include "monomial_order.h"
+#include "polynomial.h"
+#include "polynomial_set.h"
+#include "statistics.h"
+#include "variable_order.h"
+
+namespace grobner {
+
+// Computation of the basis of an affine ideal through its homogenization. The generators are
+// homogenized with an extra variable h, the basis is computed for DegRevLex, then h is set to 1
+// and the result is auto reduced. RevLexOrder decides by the variable with the smallest index,
+// so h is put at index 0 and the other variables are shifted by one: then h is the smallest
+// variable in the sense of revlex, and the dehomogenized basis is a DegRevLex basis of the
+// affine ideal. Homogeneous generators allow degree by degree processing and truncation
+// (see Algorithm::extend_to_grobners_basis_up_to).
+class Homogenization {
+  public:
+    using Order = OrderSum<DegOrder, RevLexOrder>;
+
+    // every term of f is multiplied by the power of h (variable 0) up to the degree of f,
+    // the variables of f are shifted by one
+    template<class ValueType, class MonomialType = Monomial>
+    static Polynomial<ValueType, MonomialType> homogenize(const Polynomial<ValueType, MonomialType>& f);
+    template<class ValueType, class MonomialType = Monomial>
+    static PolynomialSet<ValueType, MonomialType> homogenize(const PolynomialSet<ValueType, MonomialType>& F);
+
+    // inverse of homogenize: h is set to 1, the variables are shifted back
+    template<class ValueType, class MonomialType = Monomial>
+    static Polynomial<ValueType, MonomialType> dehomogenize(const Polynomial<ValueType, MonomialType>& f);
+    template<class ValueType, class MonomialType = Monomial>
+    static PolynomialSet<ValueType, MonomialType> dehomogenize(const PolynomialSet<ValueType, MonomialType>& F);
+
+    // F is replaced by its reduced Grobner basis for Order, the same as Algorithm gives
+    template<class ValueType, class MonomialType = Monomial>
+    static void extend_to_grobners_basis(PolynomialSet<ValueType, MonomialType>* F);
+    template<class ValueType, class Monitor, class MonomialType = Monomial>
+    static void extend_to_grobners_basis(PolynomialSet<ValueType, MonomialType>* F, Monitor* monitor);
+
+  private:
+    static std::vector<size_t> get_shift(size_t size, bool is_forward);
+};
+
+
+template<class ValueType, class MonomialType>
+Polynomial<ValueType, MonomialType> Homogenization::homogenize(const Polynomial<ValueType, MonomialType>& f) {
+    if (f.is_zero()) {
+        return f;
+    }
+    size_t size = 0;
+    auto degree = Algorithm::get_leading_term<DegOrder>(f).first.get_degree();
+    for (const auto& [monomial, coefficient] : f) {
+        size = std::max(size, monomial.container_size());
+    }
+    auto shifted = VariableOrder::permute(f, get_shift(size, true));
+    Polynomial<ValueType, MonomialType> result;
+    for (const auto& [monomial, coefficient] : shifted) {
+        auto term = monomial;
+        term.set_degree(0, degree - monomial.get_degree());
+        result.add_monomial(term, coefficient);
+    }
+    return result;
+}
+
+template<class ValueType, class MonomialType>
+PolynomialSet<ValueType, MonomialType> Homogenization::homogenize(const PolynomialSet<ValueType, MonomialType>& F) {
+    PolynomialSet<ValueType, MonomialType> result;
+    for (const auto& f : F) {
+        result.insert(homogenize(f));
+    }
+    return result;
+}
+
+template<class ValueType, class MonomialType>
+Polynomial<ValueType, MonomialType> Homogenization::dehomogenize(const Polynomial<ValueType, MonomialType>& f) {
+    size_t size = 0;
+    Polynomial<ValueType, MonomialType> result;
+    for (const auto& [monomial, coefficient] : f) {
+        auto term = monomial;
+        term.set_degree(0, 0);
+        size = std::max(size, term.container_size());
+        result.add_monomial(term, coefficient);
+    }
+    return VariableOrder::permute(result, get_shift(size, false));
+}
+
+template<class ValueType, class MonomialType>
+PolynomialSet<ValueType, MonomialType> Homogenization::dehomogenize(const PolynomialSet<ValueType, MonomialType>& F) {
+    PolynomialSet<ValueType, MonomialType> result;
+    for (const auto& f : F) {
+        auto g = dehomogenize(f);
+        if (!g.is_zero()) {
+            result.insert(std::move(g));
+        }
+    }
+    return result;
+}
+
+template<class ValueType, class MonomialType>
+void Homogenization::extend_to_grobners_basis(PolynomialSet<ValueType, MonomialType>* F) {
+    NoStatistics statistics;
+    extend_to_grobners_basis(F, &statistics);
+}
+
+template<class ValueType, class Monitor, class MonomialType>
+void Homogenization::extend_to_grobners_basis(PolynomialSet<ValueType, MonomialType>* F, Monitor* monitor) {
+    auto homogenized = homogenize(*F);
+    Algorithm::extend_to_grobners_basis<Order>(&homogenized, monitor);
+    *F = dehomogenize(homogenized);
+    Algorithm::auto_reduce<Order>(F, monitor);
+}
+
+inline std::vector<size_t> Homogenization::get_shift(size_t size, bool is_forward) {
+    // forward: i -> i + 1 for the variables of the affine ring,
+    // backward: i -> i - 1 for the variables of the homogenized ring except h
+    std::vector<size_t> shift(size);
+    for (size_t i = 0; i < size; ++i) {
+        shift[i] = is_forward ? i + 1 : (i == 0 ? 0 : i - 1);
+    }
+    return shift;
+}
+
+}  // grobner
+
+#endif  // GROBNER_HOMOGENIZATION_H_
@@ -0,0 +1,388 @@
+#ifndef GROBNER_HYBRID_RATIONAL_H_
+#define GROBNER_HYBRID_RATIONAL_H_
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/rational.hpp>
+#include <cctype>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "hashes.h"
+#include "serialization.h"
+#include "statistics.h"
+
+namespace grobner {
+
+// Rational number that is stored as a pair of long longs while it fits and as
+// boost::rational<cpp_int> otherwise. Arithmetic on small values uses overflow-checked
+// builtins and falls back to cpp_int only on overflow, results are demoted back when they fit,
+// so every value has exactly one representation.
+class HybridRational {
+  public:
+    using Integer = boost::multiprecision::cpp_int;
+    using BigRational = boost::rational<Integer>;
+
+    HybridRational(long long value = 0);
+    // throws std::domain_error if denominator is zero
+    HybridRational(long long numerator, long long denominator);
+    HybridRational(const BigRational& value);
+
+    HybridRational(const HybridRational& other);
+    HybridRational(HybridRational&& other) noexcept = default;
+    HybridRational& operator = (const HybridRational& other);
+    HybridRational& operator = (HybridRational&& other) noexcept = default;
+
+    bool is_small() const;
+    // only valid if is_small()
+    long long get_small_numerator() const;
+    long long get_small_denominator() const;
+    Integer get_numerator() const;
+    Integer get_denominator() const;
+    BigRational get_big() const;
+
+    HybridRational operator - () const;
+
+    friend HybridRational& operator += (HybridRational& first, const HybridRational& second) {
+        if (!first.is_small() || !second.is_small() || !first.add_small(second.numerator_, second.denominator_)) {
+            first.assign(first.get_big() + second.get_big());
+        }
+        return first;
+    }
+    friend HybridRational operator + (const HybridRational& first, const HybridRational& second) {
+        auto result = first;
+        result += second;
+        return result;
+    }
+    friend HybridRational& operator -= (HybridRational& first, const HybridRational& second) {
+        // small numerators are never LLONG_MIN, so negation is safe
+        if (!first.is_small() || !second.is_small() || !first.add_small(-second.numerator_, second.denominator_)) {
+            first.assign(first.get_big() - second.get_big());
+        }
+        return first;
+    }
+    friend HybridRational operator - (const HybridRational& first, const HybridRational& second) {
+        auto result = first;
+        result -= second;
+        return result;
+    }
+    friend HybridRational& operator *= (HybridRational& first, const HybridRational& second) {
+        if (!first.is_small() || !second.is_small() || !first.multiply_small(second.numerator_, second.denominator_)) {
+            first.assign(first.get_big() * second.get_big());
+        }
+        return first;
+    }
+    friend HybridRational operator * (const HybridRational& first, const HybridRational& second) {
+        auto result = first;
+        result *= second;
+        return result;
+    }
+    friend HybridRational& operator /= (HybridRational& first, const HybridRational& second) {
+        if (second.is_small() && second.numerator_ == 0) {
+            throw std::domain_error("HybridRational: division by zero");
+        }
+        bool is_done = false;
+        if (first.is_small() && second.is_small()) {
+            if (second.numerator_ > 0) {
+                is_done = first.multiply_small(second.denominator_, second.numerator_);
+            } else {
+                is_done = first.multiply_small(-second.denominator_, -second.numerator_);
+            }
+        }
+        if (!is_done) {
+            first.assign(first.get_big() / second.get_big());
+        }
+        return first;
+    }
+    friend HybridRational operator / (const HybridRational& first, const HybridRational& second) {
+        auto result = first;
+        result /= second;
+        return result;
+    }
+
+    friend bool operator == (const HybridRational& first, const HybridRational& second) {
+        if (first.is_small() != second.is_small()) {
+            return false;
+        }
+        if (first.is_small()) {
+            return first.numerator_ == second.numerator_ && first.denominator_ == second.denominator_;
+        }
+        return *first.big_ == *second.big_;
+    }
+    friend bool operator != (const HybridRational& first, const HybridRational& second) {
+        return !(first == second);
+    }
+
+    // same format as boost::rational: numerator/denominator
+    friend std::ostream& operator << (std::ostream& out, const HybridRational& value);
+    // reads [+-]digits[/digits], stops right after the last digit
+    friend std::istream& operator >> (std::istream& in, HybridRational& value);
+
+  private:
+    // fast paths, return false on overflow leaving the value unchanged
+    bool add_small(long long numerator, long long denominator);
+    bool multiply_small(long long numerator, long long denominator);
+    // numerator and denominator are coprime, denominator > 0
+    bool set_small(long long numerator, long long denominator);
+
+    void assign(const BigRational& value);
+
+    static unsigned long long get_gcd(unsigned long long a, unsigned long long b);
+    static unsigned long long get_abs(long long value);
+
+    long long numerator_ = 0;
+    long long denominator_ = 1;
+    // not null iff the value doesn't fit into numerator_ and denominator_
+    std::unique_ptr<BigRational> big_;
+};
+
+template<>
+struct CoefficientSize<HybridRational> {
+    static size_t get_bits(const HybridRational& value) {
+        if (value.is_small()) {
+            return CoefficientSize<long long>::get_bits(value.get_small_numerator()) +
+                   CoefficientSize<long long>::get_bits(value.get_small_denominator());
+        }
+        return CoefficientSize<HybridRational::BigRational>::get_bits(value.get_big());
+    }
+};
+
+template<>
+struct hash<grobner::HybridRational> {
+    size_t operator()(const grobner::HybridRational& rational) const;
+};
+
+template<>
+struct Serializer<HybridRational> {
+    static void write(std::ostream& out, const HybridRational& value);
+    static HybridRational read(std::istream& in);
+};
+
+template<>
+struct FieldName<HybridRational> {
+    static std::string get() { return "rational"; }
+};
+
+
+inline HybridRational::HybridRational(long long value) {
+    if (value == std::numeric_limits<long long>::min()) {
+        assign(BigRational(value));
+    } else {
+        numerator_ = value;
+    }
+}
+
+inline HybridRational::HybridRational(long long numerator, long long denominator) {
+    if (denominator == 0) {
+        throw std::domain_error("HybridRational: zero denominator");
+    }
+    if (denominator < 0) {
+        if (numerator == std::numeric_limits<long long>::min() || denominator == std::numeric_limits<long long>::min()) {
+            assign(BigRational(numerator, denominator));
+            return;
+        }
+        numerator = -numerator;
+        denominator = -denominator;
+    }
+    auto gcd = get_gcd(get_abs(numerator), denominator);
+    if (!set_small(numerator / (long long)gcd, denominator / (long long)gcd)) {
+        assign(BigRational(numerator, denominator));
+    }
+}
+
+inline HybridRational::HybridRational(const BigRational& value) {
+    assign(value);
+}
+
+inline HybridRational::HybridRational(const HybridRational& other) :
+    numerator_(other.numerator_),
+    denominator_(other.denominator_),
+    big_(other.big_ ? std::make_unique<BigRational>(*other.big_) : nullptr) {
+}
+
+inline HybridRational& HybridRational::operator = (const HybridRational& other) {
+    if (this != &other) {
+        numerator_ = other.numerator_;
+        denominator_ = other.denominator_;
+        big_ = other.big_ ? std::make_unique<BigRational>(*other.big_) : nullptr;
+    }
+    return *this;
+}
+
+inline bool HybridRational::is_small() const {
+    return !big_;
+}
+
+inline long long HybridRational::get_small_numerator() const {
+    return numerator_;
+}
+
+inline long long HybridRational::get_small_denominator() const {
+    return denominator_;
+}
+
+inline HybridRational::Integer HybridRational::get_numerator() const {
+    return is_small() ? Integer(numerator_) : big_->numerator();
+}
+
+inline HybridRational::Integer HybridRational::get_denominator() const {
+    return is_small() ? Integer(denominator_) : big_->denominator();
+}
+
+inline HybridRational::BigRational HybridRational::get_big() const {
+    if (is_small()) {
+        return BigRational(Integer(numerator_), Integer(denominator_));
+    }
+    return *big_;
+}
+
+inline HybridRational HybridRational::operator - () const {
+    if (is_small()) {
+        HybridRational result;
+        result.numerator_ = -numerator_;
+        result.denominator_ = denominator_;
+        return result;
+    }
+    return HybridRational(-*big_);
+}
+
+inline std::ostream& operator << (std::ostream& out, const HybridRational& value) {
+    if (value.is_small()) {
+        return out << value.numerator_ << '/' << value.denominator_;
+    }
+    return out << *value.big_;
+}
+
+inline std::istream& operator >> (std::istream& in, HybridRational& value) {
+    auto read_integer = [&in](HybridRational::Integer* result) {
+        std::string digits;
+        while (std::isdigit(in.peek())) {
+            digits += char(in.get());
+        }
+        if (digits.empty()) {
+            in.setstate(std::ios::failbit);
+            return false;
+        }
+        *result = HybridRational::Integer(digits);
+        return true;
+    };
+
+    in >> std::ws;
+    bool is_negative = false;
+    if (in.peek() == '+' || in.peek() == '-') {
+        is_negative = (in.get() == '-');
+    }
+    HybridRational::Integer numerator;
+    HybridRational::Integer denominator = 1;
+    if (!read_integer(&numerator)) {
+        return in;
+    }
+    if (in.peek() == '/') {
+        in.get();
+        if (!read_integer(&denominator)) {
+            return in;
+        }
+        if (denominator == 0) {
+            in.setstate(std::ios::failbit);
+            return in;
+        }
+    }
+    if (is_negative) {
+        numerator = -numerator;
+    }
+    value = HybridRational(HybridRational::BigRational(numerator, denominator));
+    return in;
+}
+
+inline bool HybridRational::add_small(long long numerator, long long denominator) {
+    if (denominator_ == 1 && denominator == 1) {
+        long long result;
+        if (__builtin_add_overflow(numerator_, numerator, &result)) {
+            return false;
+        }
+        return set_small(result, 1);
+    }
+    // a/b + c/d = (a * d' + c * b') / (b' * d), where g = gcd(b, d), b = b' * g, d = d' * g
+    long long gcd = get_gcd(denominator_, denominator);
+    long long first_multiplier = denominator / gcd;
+    long long second_multiplier = denominator_ / gcd;
+    long long first_part, second_part, result_numerator, result_denominator;
+    if (__builtin_mul_overflow(numerator_, first_multiplier, &first_part) ||
+            __builtin_mul_overflow(numerator, second_multiplier, &second_part) ||
+            __builtin_add_overflow(first_part, second_part, &result_numerator) ||
+            __builtin_mul_overflow(denominator_, first_multiplier, &result_denominator)) {
+        return false;
+    }
+    if (result_numerator == std::numeric_limits<long long>::min()) {
+        return false;
+    }
+    long long result_gcd = get_gcd(get_abs(result_numerator), result_denominator);
+    return set_small(result_numerator / result_gcd, result_denominator / result_gcd);
+}
+
+inline bool HybridRational::multiply_small(long long numerator, long long denominator) {
+    // cross-cancel first, so that the products are as small as possible
+    long long first_gcd = get_gcd(get_abs(numerator_), denominator);
+    long long second_gcd = get_gcd(get_abs(numerator), denominator_);
+    long long result_numerator, result_denominator;
+    if (__builtin_mul_overflow(numerator_ / first_gcd, numerator / second_gcd, &result_numerator) ||
+            __builtin_mul_overflow(denominator_ / second_gcd, denominator / first_gcd, &result_denominator)) {
+        return false;
+    }
+    return set_small(result_numerator, result_denominator);
+}
+
+inline bool HybridRational::set_small(long long numerator, long long denominator) {
+    if (numerator == std::numeric_limits<long long>::min()) {
+        return false;
+    }
+    if (numerator == 0) {
+        denominator = 1;
+    }
+    numerator_ = numerator;
+    denominator_ = denominator;
+    big_.reset();
+    return true;
+}
+
+inline void HybridRational::assign(const BigRational& value) {
+    const Integer max_value = std::numeric_limits<long long>::max();
+    if (abs(value.numerator()) <= max_value && value.denominator() <= max_value) {
+        set_small(static_cast<long long>(value.numerator()), static_cast<long long>(value.denominator()));
+    } else {
+        big_ = std::make_unique<BigRational>(value);
+    }
+}
+
+inline unsigned long long HybridRational::get_gcd(unsigned long long a, unsigned long long b) {
+    while (b != 0) {
+        a %= b;
+        std::swap(a, b);
+    }
+    return a == 0 ? 1 : a;
+}
+
+inline unsigned long long HybridRational::get_abs(long long value) {
+    return value < 0 ? 0ull - (unsigned long long)value : value;
+}
+
+inline size_t hash<grobner::HybridRational>::operator()(const grobner::HybridRational& rational) const {
+    if (rational.is_small()) {
+        return hash<long long>()(rational.get_small_numerator()) ^ hash<long long>()(rational.get_small_denominator());
+    }
+    return hash<boost::rational<grobner::HybridRational::Integer>>()(rational.get_big());
+}
+
+inline void Serializer<HybridRational>::write(std::ostream& out, const HybridRational& value) {
+    Serializer<HybridRational::BigRational>::write(out, value.get_big());
+}
+
+inline HybridRational Serializer<HybridRational>::read(std::istream& in) {
+    return HybridRational(Serializer<HybridRational::BigRational>::read(in));
+}
+
+}  // grobner
+
+#endif  // GROBNER_HYBRID_RATIONAL_H_
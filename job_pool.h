@@ -0,0 +1,321 @@
+#ifndef GROBNER_JOB_POOL_H_
+#define GROBNER_JOB_POOL_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "algorithm.h"
+#include "monomial.h"
+#include "polynomial.h"
+#include "polynomial_set.h"
+#include "statistics.h"
+
+namespace grobner {
+
+struct JobOptions {
+    // jobs with larger priority start first, equal priorities in the order of submission
+    int priority = 0;
+    // wall time since the job started, 0 means no limit
+    double time_limit_seconds = 0;
+    // estimated size of the basis and the queue of S-polynomials, 0 means no limit
+    size_t memory_limit_bytes = 0;
+};
+
+// thrown from Job::get if the job was cancelled or exceeded its budget
+class JobAborted : public std::runtime_error {
+  public:
+    enum class Reason {
+        kCancelled,
+        kTimeLimit,
+        kMemoryLimit
+    };
+
+    explicit JobAborted(Reason reason);
+
+    Reason get_reason() const;
+
+  private:
+    static std::string get_message(Reason reason);
+
+    Reason reason_;
+};
+
+// shared between a Job and the worker thread that runs it
+struct JobState {
+    std::atomic<bool> is_cancelled{false};
+};
+
+// handle of a submitted job, can be moved to and waited from any thread
+template<class ValueType>
+class Job {
+  public:
+    Job(std::future<PolynomialSet<ValueType>> future, std::shared_ptr<JobState> state);
+
+    // a queued job doesn't start, a running one stops at its next reduction step
+    void cancel();
+
+    // reduced Grobner basis; throws JobAborted or the exception of the computation
+    PolynomialSet<ValueType> get();
+    void wait() const;
+    bool is_ready() const;
+
+  private:
+    std::future<PolynomialSet<ValueType>> future_;
+    std::shared_ptr<JobState> state_;
+};
+
+// Monitor that aborts Algorithm by throwing JobAborted when the job is cancelled or out of budget.
+// The time is checked every kCheckInterval reduction steps, the memory after every iteration.
+class JobMonitor : public NoStatistics {
+  public:
+    static constexpr size_t kCheckInterval = 64;
+
+    JobMonitor(const JobState* state, const JobOptions& options);
+
+    void on_reduction_step();
+    template<class ValueType>
+    void on_iteration_finished(const PolynomialSet<ValueType>& F, const PolynomialSet<ValueType>& set_of_s);
+
+    // terms with their hash table nodes and exponent vectors, heap memory of coefficients is not counted
+    template<class ValueType>
+    static size_t estimate_bytes(const PolynomialSet<ValueType>& F);
+
+  private:
+    void check_time();
+
+    const JobState* state_;
+    JobOptions options_;
+    std::chrono::steady_clock::time_point deadline_;
+    size_t step_count_ = 0;
+};
+
+// Fixed number of worker threads computing Grobner bases of independent systems. Submitting
+// and waiting are thread-safe. Workers live as long as the pool, so allocator caches of their
+// threads are reused by the following jobs. The destructor waits for all submitted jobs.
+class JobPool {
+  public:
+    explicit JobPool(size_t thread_count = std::thread::hardware_concurrency());
+    ~JobPool();
+
+    JobPool(const JobPool&) = delete;
+    JobPool& operator = (const JobPool&) = delete;
+
+    template<class Order, class ValueType>
+    Job<ValueType> submit(PolynomialSet<ValueType> F, const JobOptions& options = JobOptions());
+
+    size_t get_thread_count() const;
+    // jobs that have not started yet
+    size_t get_queued_count() const;
+
+  private:
+    struct Task {
+        int priority;
+        uint64_t sequence_number;
+        std::function<void()> run;
+    };
+    struct TaskOrder {
+        bool operator () (const Task& a, const Task& b) const;
+    };
+
+    void run_worker();
+
+    std::vector<std::thread> threads_;
+    mutable std::mutex mutex_;
+    std::condition_variable has_task_;
+    std::priority_queue<Task, std::vector<Task>, TaskOrder> tasks_;
+    uint64_t next_sequence_number_ = 0;
+    bool is_stopping_ = false;
+};
+
+
+inline JobAborted::JobAborted(Reason reason) : std::runtime_error(get_message(reason)), reason_(reason) {}
+
+inline JobAborted::Reason JobAborted::get_reason() const {
+    return reason_;
+}
+
+inline std::string JobAborted::get_message(Reason reason) {
+    switch (reason) {
+        case Reason::kCancelled:
+            return "job cancelled";
+        case Reason::kTimeLimit:
+            return "job exceeded its time limit";
+        case Reason::kMemoryLimit:
+            return "job exceeded its memory limit";
+    }
+    return "job aborted";
+}
+
+
+template<class ValueType>
+Job<ValueType>::Job(std::future<PolynomialSet<ValueType>> future, std::shared_ptr<JobState> state) :
+    future_(std::move(future)),
+    state_(std::move(state)) {
+}
+
+template<class ValueType>
+void Job<ValueType>::cancel() {
+    state_->is_cancelled = true;
+}
+
+template<class ValueType>
+PolynomialSet<ValueType> Job<ValueType>::get() {
+    return future_.get();
+}
+
+template<class ValueType>
+void Job<ValueType>::wait() const {
+    future_.wait();
+}
+
+template<class ValueType>
+bool Job<ValueType>::is_ready() const {
+    return future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+
+inline JobMonitor::JobMonitor(const JobState* state, const JobOptions& options) :
+    state_(state),
+    options_(options),
+    deadline_(std::chrono::steady_clock::now() +
+              std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                  std::chrono::duration<double>(options.time_limit_seconds))) {
+}
+
+inline void JobMonitor::on_reduction_step() {
+    if (state_->is_cancelled.load(std::memory_order_relaxed)) {
+        throw JobAborted(JobAborted::Reason::kCancelled);
+    }
+    if (++step_count_ % kCheckInterval == 0) {
+        check_time();
+    }
+}
+
+template<class ValueType>
+void JobMonitor::on_iteration_finished(const PolynomialSet<ValueType>& F, const PolynomialSet<ValueType>& set_of_s) {
+    if (state_->is_cancelled.load(std::memory_order_relaxed)) {
+        throw JobAborted(JobAborted::Reason::kCancelled);
+    }
+    check_time();
+    if (options_.memory_limit_bytes != 0 &&
+            estimate_bytes(F) + estimate_bytes(set_of_s) > options_.memory_limit_bytes) {
+        throw JobAborted(JobAborted::Reason::kMemoryLimit);
+    }
+}
+
+template<class ValueType>
+size_t JobMonitor::estimate_bytes(const PolynomialSet<ValueType>& F) {
+    using Term = typename Polynomial<ValueType>::Containter::value_type;
+    size_t bytes = 0;
+    for (const auto& f : F) {
+        bytes += sizeof(f);
+        for (const auto& [monomial, coefficient] : f) {
+            // node with the next pointer and the cached hash, one bucket pointer
+            bytes += sizeof(Term) + 3 * sizeof(void*) + monomial.container_size() * sizeof(Monomial::DegreeType);
+        }
+    }
+    return bytes;
+}
+
+inline void JobMonitor::check_time() {
+    if (options_.time_limit_seconds > 0 && std::chrono::steady_clock::now() > deadline_) {
+        throw JobAborted(JobAborted::Reason::kTimeLimit);
+    }
+}
+
+
+inline JobPool::JobPool(size_t thread_count) {
+    for (size_t i = 0; i < std::max<size_t>(thread_count, 1); ++i) {
+        threads_.emplace_back([this]() { run_worker(); });
+    }
+}
+
+inline JobPool::~JobPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        is_stopping_ = true;
+    }
+    has_task_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+template<class Order, class ValueType>
+Job<ValueType> JobPool::submit(PolynomialSet<ValueType> F, const JobOptions& options) {
+    auto state = std::make_shared<JobState>();
+    // std::function must be copyable, so the promise and the input are shared
+    auto promise = std::make_shared<std::promise<PolynomialSet<ValueType>>>();
+    auto input = std::make_shared<PolynomialSet<ValueType>>(std::move(F));
+    Job<ValueType> job(promise->get_future(), state);
+
+    auto run = [state, promise, input, options]() {
+        try {
+            if (state->is_cancelled) {
+                throw JobAborted(JobAborted::Reason::kCancelled);
+            }
+            JobMonitor monitor(state.get(), options);
+            Algorithm::extend_to_grobners_basis<Order>(input.get(), &monitor);
+            promise->set_value(std::move(*input));
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+        input->clear();
+    };
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push({options.priority, next_sequence_number_++, std::move(run)});
+    }
+    has_task_.notify_one();
+    return job;
+}
+
+inline size_t JobPool::get_thread_count() const {
+    return threads_.size();
+}
+
+inline size_t JobPool::get_queued_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.size();
+}
+
+inline bool JobPool::TaskOrder::operator () (const Task& a, const Task& b) const {
+    // true if a runs after b
+    if (a.priority != b.priority) {
+        return a.priority < b.priority;
+    }
+    return a.sequence_number > b.sequence_number;
+}
+
+inline void JobPool::run_worker() {
+    while (true) {
+        std::function<void()> run;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            has_task_.wait(lock, [this]() { return is_stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            run = std::move(const_cast<Task&>(tasks_.top()).run);
+            tasks_.pop();
+        }
+        run();
+    }
+}
+
+}  // grobner
+
+#endif  // GROBNER_JOB_POOL_H_
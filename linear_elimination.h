@@ -0,0 +1,220 @@
+#ifndef GROBNER_LINEAR_ELIMINATION_H_
+#define GROBNER_LINEAR_ELIMINATION_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "algorithm.h"
+#include "monomial.h"
+#include "polynomial.h"
+#include "polynomial_set.h"
+#include "statistics.h"
+
+namespace grobner {
+
+// variable = value, value doesn't contain variable or any other eliminated variable
+template<class ValueType>
+struct LinearSubstitution {
+    size_t variable;
+    Polynomial<ValueType> value;
+    // variable is the leading monomial of variable - value in the order of the elimination
+    bool is_leading;
+};
+
+// Preprocessing for generators of the form c * x + (terms without x) with a constant c: x is
+// substituted out of all other generators, so the remaining system has fewer variables and
+// smaller monomials. When x is the leading monomial of its generator, the leading monomials of
+// x - value and of the basis of the remaining system are coprime, so together they already form
+// a Grobner basis of the original ideal and only tails have to be reduced; otherwise the basis
+// of the original ideal is computed from them again.
+class LinearElimination {
+  public:
+    // removes the generators linear in a variable from F one by one, shortest first, and returns
+    // the substitutions in the order they were made; in a generator, the variable that is its
+    // leading monomial in Order is preferred
+    template<class Order, class ValueType>
+    static std::vector<LinearSubstitution<ValueType>> eliminate(PolynomialSet<ValueType>* F);
+
+    // adds variable - value for every substitution to F
+    template<class ValueType>
+    static void restore(const std::vector<LinearSubstitution<ValueType>>& substitutions, PolynomialSet<ValueType>* F);
+
+    // F is replaced by its reduced Grobner basis, the same as Algorithm gives
+    template<class Order, class ValueType>
+    static void extend_to_grobners_basis(PolynomialSet<ValueType>* F);
+    template<class Order, class ValueType, class Monitor>
+    static void extend_to_grobners_basis(PolynomialSet<ValueType>* F, Monitor* monitor);
+
+    // f with variable replaced by value
+    template<class ValueType>
+    static Polynomial<ValueType> substitute(const Polynomial<ValueType>& f, size_t variable,
+                                            const Polynomial<ValueType>& value);
+
+  private:
+    static constexpr size_t kNoVariable = std::numeric_limits<size_t>::max();
+
+    // a variable that appears in f only in the term c * x, kNoVariable if there is none
+    template<class Order, class ValueType>
+    static size_t find_linear_variable(const Polynomial<ValueType>& f, bool* is_leading);
+};
+
+
+template<class Order, class ValueType>
+std::vector<LinearSubstitution<ValueType>> LinearElimination::eliminate(PolynomialSet<ValueType>* F) {
+    std::vector<LinearSubstitution<ValueType>> substitutions;
+    std::vector<Polynomial<ValueType>> generators;
+    while (!F->empty()) {
+        auto f = F->retrieve_first();
+        if (!f.is_zero()) {
+            generators.push_back(std::move(f));
+        }
+    }
+
+    while (true) {
+        std::sort(generators.begin(), generators.end(), [](const auto& a, const auto& b) { return a.size() < b.size(); });
+        size_t index = 0;
+        size_t variable = kNoVariable;
+        bool is_leading = false;
+        for (; index < generators.size(); ++index) {
+            variable = find_linear_variable<Order>(generators[index], &is_leading);
+            if (variable != kNoVariable) {
+                break;
+            }
+        }
+        if (variable == kNoVariable) {
+            break;
+        }
+
+        auto f = std::move(generators[index]);
+        generators.erase(generators.begin() + index);
+        Monomial x;
+        x.set_degree(variable, 1);
+        auto coefficient = f.get_coefficient(x);
+        // c * x + rest = 0, so x = -rest / c
+        auto value = (Polynomial<ValueType>(x) * coefficient - f) / coefficient;
+
+        std::vector<Polynomial<ValueType>> substituted;
+        substituted.reserve(generators.size());
+        for (const auto& g : generators) {
+            auto h = substitute(g, variable, value);
+            if (!h.is_zero()) {
+                substituted.push_back(std::move(h));
+            }
+        }
+        generators = std::move(substituted);
+        for (auto& substitution : substitutions) {
+            substitution.value = substitute(substitution.value, variable, value);
+        }
+        substitutions.push_back({variable, std::move(value), is_leading});
+    }
+
+    for (auto& g : generators) {
+        F->insert(std::move(g));
+    }
+    return substitutions;
+}
+
+template<class ValueType>
+void LinearElimination::restore(const std::vector<LinearSubstitution<ValueType>>& substitutions,
+                                PolynomialSet<ValueType>* F) {
+    for (const auto& substitution : substitutions) {
+        Monomial x;
+        x.set_degree(substitution.variable, 1);
+        F->insert(Polynomial<ValueType>(x) - substitution.value);
+    }
+}
+
+template<class Order, class ValueType>
+void LinearElimination::extend_to_grobners_basis(PolynomialSet<ValueType>* F) {
+    NoStatistics statistics;
+    extend_to_grobners_basis<Order>(F, &statistics);
+}
+
+template<class Order, class ValueType, class Monitor>
+void LinearElimination::extend_to_grobners_basis(PolynomialSet<ValueType>* F, Monitor* monitor) {
+    auto substitutions = eliminate<Order>(F);
+    Algorithm::extend_to_grobners_basis<Order>(F, monitor);
+    if (substitutions.empty()) {
+        return;
+    }
+    restore(substitutions, F);
+    // later substitutions into a value replace a variable by smaller terms, so the variable
+    // stays the leading monomial
+    bool are_all_leading = std::all_of(substitutions.begin(), substitutions.end(), [](const auto& substitution) {
+        return substitution.is_leading;
+    });
+    if (are_all_leading) {
+        Algorithm::auto_reduce<Order>(F, monitor);
+    } else {
+        Algorithm::extend_to_grobners_basis<Order>(F, monitor);
+    }
+}
+
+template<class ValueType>
+Polynomial<ValueType> LinearElimination::substitute(const Polynomial<ValueType>& f, size_t variable,
+                                                    const Polynomial<ValueType>& value) {
+    Polynomial<ValueType> result;
+    // powers[d] = value^d, computed when needed
+    std::vector<Polynomial<ValueType>> powers{Polynomial<ValueType>(ValueType(1))};
+    for (const auto& [monomial, coefficient] : f) {
+        auto degree = monomial.get_degree(variable);
+        if (degree == 0) {
+            result.add_monomial(monomial, coefficient);
+            continue;
+        }
+        while (powers.size() <= (size_t)degree) {
+            powers.push_back(powers.back() * value);
+        }
+        auto rest = monomial;
+        rest.set_degree(variable, 0);
+        result += powers[degree] * rest * coefficient;
+    }
+    return result;
+}
+
+template<class Order, class ValueType>
+size_t LinearElimination::find_linear_variable(const Polynomial<ValueType>& f, bool* is_leading) {
+    // occurrences[i] is the number of terms containing variable i, linear[i] is true if one of
+    // them is the variable itself
+    std::vector<size_t> occurrences;
+    std::vector<bool> linear;
+    for (const auto& [monomial, coefficient] : f) {
+        if (occurrences.size() < monomial.container_size()) {
+            occurrences.resize(monomial.container_size(), 0);
+            linear.resize(monomial.container_size(), false);
+        }
+        for (size_t i = 0; i < monomial.container_size(); ++i) {
+            if (monomial.get_degree(i) != 0) {
+                ++occurrences[i];
+                if (monomial.get_degree(i) == 1 && monomial.get_degree() == 1) {
+                    linear[i] = true;
+                }
+            }
+        }
+    }
+    if (f.is_zero()) {
+        return kNoVariable;
+    }
+    auto lead = Algorithm::get_leading_term<Order>(f).first;
+    size_t result = kNoVariable;
+    for (size_t i = 0; i < occurrences.size(); ++i) {
+        if (occurrences[i] == 1 && linear[i]) {
+            if (lead.get_degree() == 1 && lead.get_degree(i) == 1) {
+                *is_leading = true;
+                return i;
+            }
+            if (result == kNoVariable) {
+                result = i;
+            }
+        }
+    }
+    *is_leading = false;
+    return result;
+}
+
+}  // grobner
+
+#endif  // GROBNER_LINEAR_ELIMINATION_H_
@@ -1,9 +1,18 @@
 #include <iostream>
+#include <string>
 
+#include "benchmark.h"
+#include "micro_benchmarks.h"
 #include "speed_tests.h"
 #include "tests.h"
 
-int main() {
+int main(int argc, char** argv) {
+    if (argc > 1 && std::string(argv[1]) == "bench") {
+        return grobner::Benchmark::run(grobner::Benchmark::parse_options(argc - 2, argv + 2));
+    }
+    if (argc > 1 && std::string(argv[1]) == "micro") {
+        return grobner::MicroBenchmarks::run(grobner::MicroBenchmarks::parse_options(argc - 2, argv + 2));
+    }
     grobner::Tests::test_all();
     std::cout << "All tests passed\n";
     grobner::SpeedTests::run_tests();
@@ -0,0 +1,253 @@
+#ifndef GROBNER_MICRO_BENCHMARKS_H_
+#define GROBNER_MICRO_BENCHMARKS_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "algorithm.h"
+#include "allocation_counter.h"
+#include "hashes.h"
+#include "modular.h"
+#include "monomial.h"
+#include "monomial_order.h"
+#include "polynomial.h"
+
+namespace grobner {
+
+struct MicroBenchmarkOptions {
+    int variable_count = 8;
+    // maximal total degree of random monomials
+    int degree = 6;
+    // number of terms in random polynomials
+    int term_count = 16;
+    int iterations = 200'000;
+    unsigned seed = 0;
+    // runs only kernels whose name contains this
+    std::string filter;
+};
+
+struct MicroBenchmarkResult {
+    std::string name;
+    double nanoseconds_per_operation = 0;
+    double allocations_per_operation = 0;
+};
+
+class MicroBenchmarks {
+  public:
+    // parses "--variables 8 --degree 6 --terms 16 --iterations 200000 --seed 0 --filter monomial"
+    inline static MicroBenchmarkOptions parse_options(int argc, char** argv);
+
+    // prints results as json, one kernel per line
+    inline static int run(const MicroBenchmarkOptions& options);
+
+    inline static std::vector<MicroBenchmarkResult> run_all(const MicroBenchmarkOptions& options);
+
+  private:
+    // calls function(i) for i in [0, iterations), function returns something to keep the result alive
+    template<class Function>
+    inline static MicroBenchmarkResult measure(const std::string& name, int iterations, Function function);
+
+    inline static Monomial get_random_monomial(const MicroBenchmarkOptions& options, std::mt19937* random);
+    template<class ValueType>
+    inline static Polynomial<ValueType> get_random_polynomial(const MicroBenchmarkOptions& options,
+                                                              std::mt19937* random);
+
+    inline static volatile size_t sink_ = 0;
+};
+
+
+MicroBenchmarkOptions MicroBenchmarks::parse_options(int argc, char** argv) {
+    MicroBenchmarkOptions options;
+    for (int i = 0; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        std::string value = argv[i + 1];
+        if (key == "--variables") {
+            options.variable_count = std::stoi(value);
+        } else if (key == "--degree") {
+            options.degree = std::stoi(value);
+        } else if (key == "--terms") {
+            options.term_count = std::stoi(value);
+        } else if (key == "--iterations") {
+            options.iterations = std::stoi(value);
+        } else if (key == "--seed") {
+            options.seed = std::stoul(value);
+        } else if (key == "--filter") {
+            options.filter = value;
+        } else {
+            std::cerr << "Unknown option: " << key << std::endl;
+            std::exit(1);
+        }
+    }
+    if (argc % 2 == 1) {
+        std::cerr << "Missing value for option " << argv[argc - 1] << std::endl;
+        std::exit(1);
+    }
+    return options;
+}
+
+int MicroBenchmarks::run(const MicroBenchmarkOptions& options) {
+    auto results = run_all(options);
+    std::cout << std::setprecision(6) << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        std::cout << "  {\"name\": \"" << results[i].name << "\", "
+                  << "\"variables\": " << options.variable_count << ", "
+                  << "\"degree\": " << options.degree << ", "
+                  << "\"terms\": " << options.term_count << ", "
+                  << "\"ns_per_op\": " << results[i].nanoseconds_per_operation << ", "
+                  << "\"allocations_per_op\": ";
+        // null if allocation_counter.cpp is not linked
+        if (AllocationCounter::is_enabled()) {
+            std::cout << results[i].allocations_per_operation;
+        } else {
+            std::cout << "null";
+        }
+        std::cout << "}"
+                  << (i + 1 == results.size() ? "" : ",") << "\n";
+    }
+    std::cout << "]\n";
+    return 0;
+}
+
+std::vector<MicroBenchmarkResult> MicroBenchmarks::run_all(const MicroBenchmarkOptions& options) {
+    using Modular = grobner::Modular<1'000'000'007ll>;
+    using Poly = Polynomial<Modular>;
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    // inputs are cycled through, so that the working set stays in cache and the results are comparable
+    const size_t input_count = 256;
+
+    std::mt19937 random(options.seed);
+    std::vector<Monomial> monomials;
+    std::vector<Monomial> divisors;
+    std::vector<Poly> polynomials;
+    std::vector<Modular> coefficients;
+    for (size_t i = 0; i < input_count; ++i) {
+        monomials.push_back(get_random_monomial(options, &random));
+        polynomials.push_back(get_random_polynomial<Modular>(options, &random));
+        coefficients.push_back(Modular(std::uniform_int_distribution<long long>(1, 1'000'000'006ll)(random)));
+    }
+    for (size_t i = 0; i < input_count; ++i) {
+        // every second divisor actually divides
+        divisors.push_back(i % 2 == 0 ? Algorithm::get_LCM(monomials[i], monomials[(i + 1) % input_count]) :
+                                        monomials[(i + 1) % input_count]);
+    }
+
+    auto is_selected = [&](const std::string& name) {
+        return options.filter.empty() || name.find(options.filter) != std::string::npos;
+    };
+
+    std::vector<MicroBenchmarkResult> results;
+    if (is_selected("monomial_multiply")) {
+        results.push_back(measure("monomial_multiply", options.iterations, [&](size_t i) {
+            return (monomials[i % input_count] * monomials[(i + 1) % input_count]).container_size();
+        }));
+    }
+    if (is_selected("monomial_divide")) {
+        results.push_back(measure("monomial_divide", options.iterations, [&](size_t i) {
+            return (divisors[i % input_count] / monomials[i % input_count]).container_size();
+        }));
+    }
+    if (is_selected("monomial_is_divisible_by")) {
+        results.push_back(measure("monomial_is_divisible_by", options.iterations, [&](size_t i) {
+            return size_t(divisors[i % input_count].is_divisible_by(monomials[i % input_count]));
+        }));
+    }
+    if (is_selected("get_LCM")) {
+        results.push_back(measure("get_LCM", options.iterations, [&](size_t i) {
+            return Algorithm::get_LCM(monomials[i % input_count], monomials[(i + 1) % input_count]).container_size();
+        }));
+    }
+    if (is_selected("degrevlex_cmp")) {
+        results.push_back(measure("degrevlex_cmp", options.iterations, [&](size_t i) {
+            return size_t(DegRevLex::cmp(monomials[i % input_count], monomials[(i + 1) % input_count]) + 1);
+        }));
+    }
+    if (is_selected("monomial_hash")) {
+        results.push_back(measure("monomial_hash", options.iterations, [&](size_t i) {
+            return hash<Monomial>()(monomials[i % input_count]);
+        }));
+    }
+    if (is_selected("polynomial_add_monomial")) {
+        Poly accumulator;
+        results.push_back(measure("polynomial_add_monomial", options.iterations, [&](size_t i) {
+            accumulator.add_monomial(monomials[i % input_count], coefficients[i % input_count]);
+            return size_t(accumulator.is_zero());
+        }));
+    }
+    if (is_selected("polynomial_subtract")) {
+        Poly accumulator;
+        results.push_back(measure("polynomial_subtract", options.iterations, [&](size_t i) {
+            accumulator -= polynomials[i % input_count];
+            return size_t(accumulator.is_zero());
+        }));
+    }
+    if (is_selected("polynomial_multiply_monomial")) {
+        results.push_back(measure("polynomial_multiply_monomial", options.iterations, [&](size_t i) {
+            return size_t((polynomials[i % input_count] * monomials[i % input_count]).is_zero());
+        }));
+    }
+    if (is_selected("polynomial_multiply")) {
+        // term_count^2 monomial products per operation, so fewer iterations
+        results.push_back(measure("polynomial_multiply", std::max(1, options.iterations / options.term_count),
+                                  [&](size_t i) {
+            return size_t((polynomials[i % input_count] * polynomials[(i + 1) % input_count]).size());
+        }));
+    }
+    if (is_selected("modular_get_inverse")) {
+        results.push_back(measure("modular_get_inverse", options.iterations, [&](size_t i) {
+            return size_t(coefficients[i % input_count].get_inverse().get_value());
+        }));
+    }
+    return results;
+}
+
+template<class Function>
+MicroBenchmarkResult MicroBenchmarks::measure(const std::string& name, int iterations, Function function) {
+    size_t allocations_before = AllocationCounter::get_allocation_count();
+    auto start = std::chrono::steady_clock::now();
+    size_t result = 0;
+    for (int i = 0; i < iterations; ++i) {
+        result += function(i);
+    }
+    auto finish = std::chrono::steady_clock::now();
+    size_t allocations = AllocationCounter::get_allocation_count() - allocations_before;
+    sink_ = sink_ + result;
+
+    MicroBenchmarkResult benchmark_result;
+    benchmark_result.name = name;
+    benchmark_result.nanoseconds_per_operation =
+        std::chrono::duration<double, std::nano>(finish - start).count() / std::max(iterations, 1);
+    benchmark_result.allocations_per_operation = double(allocations) / std::max(iterations, 1);
+    return benchmark_result;
+}
+
+Monomial MicroBenchmarks::get_random_monomial(const MicroBenchmarkOptions& options, std::mt19937* random) {
+    Monomial result;
+    int degree = std::uniform_int_distribution<int>(0, options.degree)(*random);
+    for (int d = 0; d < degree; ++d) {
+        int variable = std::uniform_int_distribution<int>(0, options.variable_count - 1)(*random);
+        result.set_degree(variable, result.get_degree(variable) + 1);
+    }
+    return result;
+}
+
+template<class ValueType>
+Polynomial<ValueType> MicroBenchmarks::get_random_polynomial(const MicroBenchmarkOptions& options,
+                                                             std::mt19937* random) {
+    Polynomial<ValueType> result;
+    for (int i = 0; i < options.term_count; ++i) {
+        result.add_monomial(get_random_monomial(options, random),
+                            ValueType(std::uniform_int_distribution<int>(1, 1000)(*random)));
+    }
+    return result;
+}
+
+}  // grobner
+
+#endif  // GROBNER_MICRO_BENCHMARKS_H_
@@ -3,6 +3,8 @@
 
 #include <iostream>
 
+#include "statistics.h"
+
 namespace grobner {
 
 // some methods work correctly only with prime P (get_inverse, division)
@@ -78,6 +80,13 @@ class Modular {
     void normalize();
 };
 
+template<auto P>
+struct CoefficientSize<Modular<P>> {
+    static size_t get_bits(const Modular<P>& value) {
+        return CoefficientSize<typename Modular<P>::ValueType>::get_bits(value.get_value());
+    }
+};
+
 template<auto P>
 Modular<P>::Modular(typename Modular<P>::ValueType value) : value_(make_normal(value)) {}
 
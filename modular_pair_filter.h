@@ -0,0 +1,300 @@
+#ifndef GROBNER_MODULAR_PAIR_FILTER_H_
+#define GROBNER_MODULAR_PAIR_FILTER_H_
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/rational.hpp>
+#include <type_traits>
+
+#include "algorithm.h"
+#include "hybrid_rational.h"
+#include "modular.h"
+#include "pair_filter.h"
+#include "polynomial.h"
+#include "polynomial_basis.h"
+#include "polynomial_set.h"
+#include "statistics.h"
+
+namespace grobner {
+
+// Image of a rational number modulo P, fails if the denominator is divisible by P.
+template<auto P>
+struct ModularImage {
+    template<class IntType>
+    static bool get(const boost::rational<IntType>& value, Modular<P>* result);
+    static bool get(const HybridRational& value, Modular<P>* result);
+
+    // false if some denominator is divisible by P
+    template<class ValueType>
+    static bool get(const Polynomial<ValueType>& f, Polynomial<Modular<P>>* result);
+
+  private:
+    template<class IntType>
+    static Modular<P> get_residue(const IntType& value);
+    template<class IntType>
+    static bool get(const IntType& numerator, const IntType& denominator, Modular<P>* result);
+};
+
+// value types that ModularImage maps to Modular<P>
+template<class ValueType>
+struct HasModularImage : std::false_type {};
+
+template<class IntType>
+struct HasModularImage<boost::rational<IntType>> : std::true_type {};
+
+template<>
+struct HasModularImage<HybridRational> : std::true_type {};
+
+// Pair filter for rational coefficients: keeps the image of the basis modulo a prime P and drops
+// an S-polynomial if its image reduces to zero there, which is much cheaper than the reduction
+// over Q. This is a heuristic: the image can reduce to zero while S doesn't, e.g. when P divides
+// a coefficient that appears during the reduction. For P around 2^31 it doesn't happen in
+// practice, but it is not excluded. verification_interval controls how often a drop is checked
+// by the exact reduction instead: 1 always (exact, only measures), n every n-th drop, 0 never.
+// A checked S-polynomial is reduced by Algorithm as usual, so a false zero goes into the basis,
+// and the filter switches itself off after it: the heuristic is not trusted for this input any
+// more. The S-polynomials dropped before that are not recovered by Algorithm (see
+// ModularFilteredAlgorithm); is_result_proven() tells whether the result depends on unchecked
+// drops at all.
+template<auto P = 2'147'483'647ll>
+class ModularPairFilter {
+  public:
+    using Modular = grobner::Modular<P>;
+
+    static constexpr size_t kDefaultVerificationInterval = 16;
+
+    explicit ModularPairFilter(size_t verification_interval = kDefaultVerificationInterval);
+
+    template<class Order, class ValueType>
+    void set_basis(const PolynomialSet<ValueType>& F);
+    template<class Order, class ValueType>
+    bool is_reduced_to_zero(const Polynomial<ValueType>& S);
+    template<class ValueType>
+    void on_reduction_finished(const Polynomial<ValueType>& S);
+
+    // S-polynomials that were checked modulo P
+    size_t get_tested_count() const;
+    // their images reduced to zero
+    size_t get_zero_count() const;
+    // dropped without the exact reduction
+    size_t get_skipped_count() const;
+    size_t get_verified_count() const;
+    // verified zeros that are not zero over Q
+    size_t get_false_zero_count() const;
+
+    // a false zero was found, nothing is dropped since then
+    bool is_disabled() const;
+    // no S-polynomial was dropped without the exact reduction, so the basis is exact; otherwise
+    // it is correct only if none of the get_skipped_count() drops was a false zero
+    bool is_result_proven() const;
+
+  private:
+    size_t verification_interval_;
+
+    PolynomialBasis<Modular> basis_;
+    // false if the basis has no good image modulo P, then nothing is dropped
+    bool is_basis_valid_ = false;
+    bool is_verifying_ = false;
+    bool is_disabled_ = false;
+
+    size_t tested_count_ = 0;
+    size_t zero_count_ = 0;
+    size_t skipped_count_ = 0;
+    size_t verified_count_ = 0;
+    size_t false_zero_count_ = 0;
+};
+
+// Algorithm::extend_to_grobners_basis with ModularPairFilter<>, same interface as Algorithm
+// and FractionFreeAlgorithm, used by the benchmark. If the filter switched itself off, the
+// S-polynomials it had dropped are lost, so the computation is continued from the result without
+// the filter and the result is exact. Returns true if the result is proven (is_result_proven).
+class ModularFilteredAlgorithm {
+  public:
+    template<class Order, class ValueType>
+    static bool extend_to_grobners_basis(PolynomialSet<ValueType>* F);
+    template<class Order, class ValueType, class Monitor>
+    static bool extend_to_grobners_basis(PolynomialSet<ValueType>* F, Monitor* monitor);
+    // with a filter of the caller, e.g. with another P or verification interval
+    template<class Order, class ValueType, class Monitor, auto P>
+    static bool extend_to_grobners_basis(PolynomialSet<ValueType>* F, Monitor* monitor, ModularPairFilter<P>* filter);
+};
+
+
+template<auto P>
+template<class IntType>
+bool ModularImage<P>::get(const boost::rational<IntType>& value, Modular<P>* result) {
+    return get(value.numerator(), value.denominator(), result);
+}
+
+template<auto P>
+bool ModularImage<P>::get(const HybridRational& value, Modular<P>* result) {
+    if (value.is_small()) {
+        return get(value.get_small_numerator(), value.get_small_denominator(), result);
+    }
+    return get(value.get_numerator(), value.get_denominator(), result);
+}
+
+template<auto P>
+template<class ValueType>
+bool ModularImage<P>::get(const Polynomial<ValueType>& f, Polynomial<Modular<P>>* result) {
+    result->set_to_zero();
+    for (const auto& [monomial, coefficient] : f) {
+        Modular<P> image;
+        if (!get(coefficient, &image)) {
+            return false;
+        }
+        result->add_monomial(monomial, image);
+    }
+    return true;
+}
+
+template<auto P>
+template<class IntType>
+Modular<P> ModularImage<P>::get_residue(const IntType& value) {
+    if constexpr (std::is_integral_v<IntType>) {
+        return Modular<P>(static_cast<typename Modular<P>::ValueType>(value % IntType(P)));
+    } else {
+        return Modular<P>(static_cast<typename Modular<P>::ValueType>(IntType(value % P)));
+    }
+}
+
+template<auto P>
+template<class IntType>
+bool ModularImage<P>::get(const IntType& numerator, const IntType& denominator, Modular<P>* result) {
+    auto denominator_residue = get_residue(denominator);
+    if (denominator_residue == Modular<P>(0)) {
+        return false;
+    }
+    *result = get_residue(numerator) / denominator_residue;
+    return true;
+}
+
+
+template<auto P>
+ModularPairFilter<P>::ModularPairFilter(size_t verification_interval) :
+    verification_interval_(verification_interval) {
+}
+
+template<auto P>
+template<class Order, class ValueType>
+void ModularPairFilter<P>::set_basis(const PolynomialSet<ValueType>& F) {
+    // same order of reducers as in Algorithm::reduce_by(F, ...)
+    basis_ = PolynomialBasis<Modular>();
+    is_basis_valid_ = true;
+    Polynomial<Modular> image;
+    for (const auto& f : F) {
+        auto lead = Algorithm::get_leading_term<Order>(f).first;
+        if (!ModularImage<P>::get(f, &image) || image.is_zero() ||
+                Algorithm::get_leading_term<Order>(image).first != lead) {
+            is_basis_valid_ = false;
+            return;
+        }
+        basis_.insert(std::move(image));
+    }
+}
+
+template<auto P>
+template<class Order, class ValueType>
+bool ModularPairFilter<P>::is_reduced_to_zero(const Polynomial<ValueType>& S) {
+    is_verifying_ = false;
+    if (is_disabled_ || !is_basis_valid_) {
+        return false;
+    }
+    Polynomial<Modular> image;
+    if (!ModularImage<P>::get(S, &image)) {
+        return false;
+    }
+    ++tested_count_;
+    NoStatistics statistics;
+    Algorithm::reduce_by<Order>(basis_, &image, &statistics);
+    if (!image.is_zero()) {
+        return false;
+    }
+    ++zero_count_;
+    if (verification_interval_ != 0 && zero_count_ % verification_interval_ == 0) {
+        is_verifying_ = true;
+        return false;
+    }
+    ++skipped_count_;
+    return true;
+}
+
+template<auto P>
+template<class ValueType>
+void ModularPairFilter<P>::on_reduction_finished(const Polynomial<ValueType>& S) {
+    if (!is_verifying_) {
+        return;
+    }
+    is_verifying_ = false;
+    ++verified_count_;
+    if (!S.is_zero()) {
+        ++false_zero_count_;
+        is_disabled_ = true;
+    }
+}
+
+template<auto P>
+size_t ModularPairFilter<P>::get_tested_count() const {
+    return tested_count_;
+}
+
+template<auto P>
+size_t ModularPairFilter<P>::get_zero_count() const {
+    return zero_count_;
+}
+
+template<auto P>
+size_t ModularPairFilter<P>::get_skipped_count() const {
+    return skipped_count_;
+}
+
+template<auto P>
+size_t ModularPairFilter<P>::get_verified_count() const {
+    return verified_count_;
+}
+
+template<auto P>
+size_t ModularPairFilter<P>::get_false_zero_count() const {
+    return false_zero_count_;
+}
+
+template<auto P>
+bool ModularPairFilter<P>::is_disabled() const {
+    return is_disabled_;
+}
+
+template<auto P>
+bool ModularPairFilter<P>::is_result_proven() const {
+    return skipped_count_ == 0;
+}
+
+
+template<class Order, class ValueType>
+bool ModularFilteredAlgorithm::extend_to_grobners_basis(PolynomialSet<ValueType>* F) {
+    NoStatistics statistics;
+    return extend_to_grobners_basis<Order>(F, &statistics);
+}
+
+template<class Order, class ValueType, class Monitor>
+bool ModularFilteredAlgorithm::extend_to_grobners_basis(PolynomialSet<ValueType>* F, Monitor* monitor) {
+    ModularPairFilter<> filter;
+    return extend_to_grobners_basis<Order>(F, monitor, &filter);
+}
+
+template<class Order, class ValueType, class Monitor, auto P>
+bool ModularFilteredAlgorithm::extend_to_grobners_basis(PolynomialSet<ValueType>* F, Monitor* monitor,
+                                                        ModularPairFilter<P>* filter) {
+    Algorithm::extend_to_grobners_basis<Order>(F, monitor, filter);
+    if (filter->is_result_proven()) {
+        return true;
+    }
+    if (filter->is_disabled()) {
+        // F generates the same ideal, the pairs of the dropped S-polynomials are formed again
+        Algorithm::extend_to_grobners_basis<Order>(F, monitor);
+        return true;
+    }
+    return false;
+}
+
+}  // grobner
+
+#endif  // GROBNER_MODULAR_PAIR_FILTER_H_
@@ -43,7 +43,8 @@ class Monomial {
     }
     friend Monomial operator * (const Monomial& first, const Monomial& second) {
         auto result = first;
-        return result *= second;
+        result *= second;
+        return result;
     }
 
     friend Monomial& operator /= (Monomial& first, const Monomial& second) {
@@ -58,7 +59,8 @@ class Monomial {
     }
     friend Monomial operator / (const Monomial& first, const Monomial& second) {
         auto result = first;
-        return result /= second;
+        result /= second;
+        return result;
     }
 
     friend bool operator == (const Monomial& first, const Monomial& second) {
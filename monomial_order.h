@@ -2,6 +2,7 @@
 #define GROBNER_ORDER_H_
 
 #include "monomial.h"
+#include "sparse_monomial.h"
 
 namespace grobner {
 
@@ -9,29 +10,37 @@ template<class FirstOrder, class SecondOrder>
 class OrderSum {
   public:
     static int cmp(const Monomial& first, const Monomial& second);
+    static int cmp(const SparseMonomial& first, const SparseMonomial& second);
 
     bool operator()(const Monomial& first, const Monomial& second) const;
+    bool operator()(const SparseMonomial& first, const SparseMonomial& second) const;
 };
 
 class DegOrder {
   public:
     static int cmp(const Monomial& first, const Monomial& second);
+    static int cmp(const SparseMonomial& first, const SparseMonomial& second);
 
     bool operator()(const Monomial& first, const Monomial& second) const;
+    bool operator()(const SparseMonomial& first, const SparseMonomial& second) const;
 };
 
 class LexOrder {
   public:
     static int cmp(const Monomial& first, const Monomial& second);
+    static int cmp(const SparseMonomial& first, const SparseMonomial& second);
 
     bool operator()(const Monomial& first, const Monomial& second) const;
+    bool operator()(const SparseMonomial& first, const SparseMonomial& second) const;
 };
 
 class RevLexOrder {
   public:
     static int cmp(const Monomial& first, const Monomial& second);
+    static int cmp(const SparseMonomial& first, const SparseMonomial& second);
 
     bool operator()(const Monomial& first, const Monomial& second) const;
+    bool operator()(const SparseMonomial& first, const SparseMonomial& second) const;
 };
 
 
@@ -44,11 +53,25 @@ int OrderSum<FirstOrder, SecondOrder>::cmp(const Monomial& first, const Monomial
     return cmp_first;
 }
 
+template<class FirstOrder, class SecondOrder>
+int OrderSum<FirstOrder, SecondOrder>::cmp(const SparseMonomial& first, const SparseMonomial& second) {
+    int cmp_first = FirstOrder::cmp(first, second);
+    if (cmp_first == 0) {
+        return SecondOrder::cmp(first, second);
+    }
+    return cmp_first;
+}
+
 template<class FirstOrder, class SecondOrder>
 bool OrderSum<FirstOrder, SecondOrder>::operator()(const Monomial& first, const Monomial& second) const {
     return cmp(first, second) < 0;
 }
 
+template<class FirstOrder, class SecondOrder>
+bool OrderSum<FirstOrder, SecondOrder>::operator()(const SparseMonomial& first, const SparseMonomial& second) const {
+    return cmp(first, second) < 0;
+}
+
 
 int DegOrder::cmp(const Monomial& first, const Monomial& second) {
     auto first_degree = first.get_degree();
@@ -62,10 +85,26 @@ int DegOrder::cmp(const Monomial& first, const Monomial& second) {
     }
 }
 
+inline int DegOrder::cmp(const SparseMonomial& first, const SparseMonomial& second) {
+    auto first_degree = first.get_degree();
+    auto second_degree = second.get_degree();
+    if (first_degree < second_degree) {
+        return -1;
+    } else if (first_degree == second_degree) {
+        return 0;
+    } else {
+        return 1;
+    }
+}
+
 bool DegOrder::operator()(const Monomial& first, const Monomial& second) const {
     return cmp(first, second) < 0;
 }
 
+inline bool DegOrder::operator()(const SparseMonomial& first, const SparseMonomial& second) const {
+    return cmp(first, second) < 0;
+}
+
 
 int LexOrder::cmp(const Monomial& first, const Monomial& second) {
     for (size_t i = 0; i < std::max(first.container_size(), second.container_size()); ++i) {
@@ -78,10 +117,38 @@ int LexOrder::cmp(const Monomial& first, const Monomial& second) {
     return 0;
 }
 
+// the first variable present in only one of the monomials, or with different degrees, decides
+inline int LexOrder::cmp(const SparseMonomial& first, const SparseMonomial& second) {
+    const auto& first_powers = first.get_powers();
+    const auto& second_powers = second.get_powers();
+    size_t i = 0;
+    while (i < first_powers.size() && i < second_powers.size()) {
+        if (first_powers[i].first != second_powers[i].first) {
+            // the other monomial has degree 0 in the smaller variable
+            return first_powers[i].first < second_powers[i].first ? (first_powers[i].second > 0 ? 1 : -1)
+                                                                  : (second_powers[i].second > 0 ? -1 : 1);
+        }
+        if (first_powers[i].second != second_powers[i].second) {
+            return first_powers[i].second < second_powers[i].second ? -1 : 1;
+        }
+        ++i;
+    }
+    if (i < first_powers.size()) {
+        return first_powers[i].second > 0 ? 1 : -1;
+    } else if (i < second_powers.size()) {
+        return second_powers[i].second > 0 ? -1 : 1;
+    }
+    return 0;
+}
+
 bool LexOrder::operator()(const Monomial& first, const Monomial& second) const {
     return cmp(first, second) < 0;
 }
 
+inline bool LexOrder::operator()(const SparseMonomial& first, const SparseMonomial& second) const {
+    return cmp(first, second) < 0;
+}
+
 
 int RevLexOrder::cmp(const Monomial& first, const Monomial& second) {
     for (size_t i = 0; i < std::max(first.container_size(), second.container_size()); ++i) {
@@ -94,10 +161,19 @@ int RevLexOrder::cmp(const Monomial& first, const Monomial& second) {
     return 0;
 }
 
+// the same variable decides as for LexOrder, with the opposite result
+inline int RevLexOrder::cmp(const SparseMonomial& first, const SparseMonomial& second) {
+    return LexOrder::cmp(second, first);
+}
+
 bool RevLexOrder::operator()(const Monomial& first, const Monomial& second) const {
     return cmp(first, second) < 0;
 }
 
+inline bool RevLexOrder::operator()(const SparseMonomial& first, const SparseMonomial& second) const {
+    return cmp(first, second) < 0;
+}
+
 }  // grobner
 
 #endif  // GROBNER_ORDER_H_
@@ -0,0 +1,532 @@
+#ifndef GROBNER_MULTI_PRIME_H_
+#define GROBNER_MULTI_PRIME_H_
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/rational.hpp>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "algorithm.h"
+#include "dyn_modular.h"
+#include "hybrid_rational.h"
+#include "polynomial.h"
+#include "polynomial_set.h"
+#include "serialization.h"
+
+namespace grobner {
+
+// reduced basis of the input modulo one prime
+struct PrimeImage {
+    long long prime = 0;
+    // false if the prime divides a denominator of the input or the computation failed
+    bool is_valid = false;
+    // residues modulo prime, use them inside a DynModular::FieldScope of this prime
+    PolynomialSet<DynModular> basis;
+};
+
+// Multi-modular driver: computes the reduced bases of a system over Q (or Z) modulo many primes
+// concurrently, either on threads of this process or in worker processes forked by the library,
+// which receive primes and stream the bases back over pipes. The images are then combined by
+// the Chinese remainder theorem and rational reconstruction.
+class MultiPrime {
+  public:
+    using Integer = boost::multiprecision::cpp_int;
+    using Rational = boost::rational<Integer>;
+
+    // count largest primes below upper_bound, which is at most 2^32 (see PrimeField)
+    inline static std::vector<long long> get_primes(size_t count, long long upper_bound = 2'147'483'648ll);
+
+    // images[i] is the basis modulo primes[i], a prime whose computation throws gets an invalid
+    // image; throws std::invalid_argument if primes has duplicates
+    template<class Order, class ValueType>
+    static std::vector<PrimeImage> compute_on_threads(const PolynomialSet<ValueType>& F,
+                                                      const std::vector<long long>& primes,
+                                                      size_t thread_count = std::thread::hardware_concurrency());
+    // worker processes share F with the parent through fork, a worker that dies makes its current
+    // prime invalid and gets no more primes
+    template<class Order, class ValueType>
+    static std::vector<PrimeImage> compute_in_processes(const PolynomialSet<ValueType>& F,
+                                                        const std::vector<long long>& primes,
+                                                        size_t process_count = std::thread::hardware_concurrency());
+
+    // CRT of the valid images whose leading monomials are the same as in most of them (the other
+    // primes are unlucky), coefficients are in [0, modulus); false if there are no valid images
+    template<class Order>
+    static bool combine(const std::vector<PrimeImage>& images, PolynomialSet<Integer>* result, Integer* modulus);
+    // coefficient-wise rational reconstruction, false if some coefficient has no small enough preimage
+    inline static bool reconstruct(const PolynomialSet<Integer>& F, const Integer& modulus,
+                                   PolynomialSet<Rational>* result);
+
+    // images in the current DynModular field, false if its modulus divides a denominator
+    template<class IntType>
+    static bool get_image(const boost::rational<IntType>& value, DynModular* result);
+    inline static bool get_image(const HybridRational& value, DynModular* result);
+    template<class IntType>
+    static bool get_image(const IntType& value, DynModular* result);
+    template<class ValueType>
+    static bool get_image(const PolynomialSet<ValueType>& F, PolynomialSet<DynModular>* result);
+
+  private:
+    // throws std::invalid_argument if some prime is repeated, combine would count it twice
+    inline static void check_primes(const std::vector<long long>& primes);
+    // computes the image of F modulo prime, must be called with no DynModular field in scope
+    template<class Order, class ValueType>
+    static PrimeImage compute_image(const PolynomialSet<ValueType>& F, long long prime);
+
+    template<class IntType>
+    static DynModular get_residue(const IntType& value);
+    inline static bool reconstruct(const Integer& value, const Integer& modulus, Rational* result);
+
+    template<class Order, class ValueType>
+    static void run_worker(const PolynomialSet<ValueType>& F, const std::vector<long long>& primes, int task_fd,
+                           int result_fd);
+    // false on end of file or error
+    inline static bool read_exactly(int fd, void* data, size_t size);
+    inline static bool write_exactly(int fd, const void* data, size_t size);
+};
+
+
+std::vector<long long> MultiPrime::get_primes(size_t count, long long upper_bound) {
+    std::vector<long long> primes;
+    for (long long candidate = upper_bound - 1; candidate >= 2 && primes.size() < count; --candidate) {
+        bool is_prime = true;
+        for (long long divisor = 2; divisor * divisor <= candidate; ++divisor) {
+            if (candidate % divisor == 0) {
+                is_prime = false;
+                break;
+            }
+        }
+        if (is_prime) {
+            primes.push_back(candidate);
+        }
+    }
+    return primes;
+}
+
+template<class Order, class ValueType>
+std::vector<PrimeImage> MultiPrime::compute_on_threads(const PolynomialSet<ValueType>& F,
+                                                       const std::vector<long long>& primes, size_t thread_count) {
+    check_primes(primes);
+    std::vector<PrimeImage> images(primes.size());
+    for (size_t i = 0; i < primes.size(); ++i) {
+        images[i].prime = primes[i];
+    }
+    std::atomic<size_t> next_index{0};
+    auto work = [&]() {
+        for (size_t i = next_index++; i < primes.size(); i = next_index++) {
+            // an exception must not escape the thread, the image stays invalid as in run_worker
+            try {
+                images[i] = compute_image<Order>(F, primes[i]);
+            } catch (const std::exception&) {
+                images[i].is_valid = false;
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < std::max<size_t>(std::min(thread_count, primes.size()), 1); ++i) {
+        threads.emplace_back(work);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return images;
+}
+
+template<class Order, class ValueType>
+std::vector<PrimeImage> MultiPrime::compute_in_processes(const PolynomialSet<ValueType>& F,
+                                                         const std::vector<long long>& primes, size_t process_count) {
+    struct Worker {
+        pid_t pid = -1;
+        int task_fd = -1;
+        int result_fd = -1;
+        bool is_busy = false;
+    };
+
+    check_primes(primes);
+    std::vector<PrimeImage> images(primes.size());
+    for (size_t i = 0; i < primes.size(); ++i) {
+        images[i].prime = primes[i];
+    }
+    process_count = std::min(std::max<size_t>(process_count, 1), primes.size());
+    // buffered output would be printed by every child too
+    std::cout.flush();
+    std::cerr.flush();
+
+    std::vector<Worker> workers;
+    for (size_t i = 0; i < process_count; ++i) {
+        int task_pipe[2], result_pipe[2];
+        if (pipe(task_pipe) != 0) {
+            break;
+        }
+        if (pipe(result_pipe) != 0) {
+            close(task_pipe[0]);
+            close(task_pipe[1]);
+            break;
+        }
+        pid_t pid = fork();
+        if (pid == 0) {
+            // the write ends of other workers' task pipes must be closed, otherwise they never see the end
+            for (const auto& worker : workers) {
+                close(worker.task_fd);
+                close(worker.result_fd);
+            }
+            close(task_pipe[1]);
+            close(result_pipe[0]);
+            run_worker<Order>(F, primes, task_pipe[0], result_pipe[1]);
+            _exit(0);
+        }
+        close(task_pipe[0]);
+        close(result_pipe[1]);
+        if (pid < 0) {
+            close(task_pipe[1]);
+            close(result_pipe[0]);
+            break;
+        }
+        Worker worker;
+        worker.pid = pid;
+        worker.task_fd = task_pipe[1];
+        worker.result_fd = result_pipe[0];
+        workers.push_back(worker);
+    }
+
+    // a dead worker must not kill the parent with SIGPIPE
+    auto previous_handler = signal(SIGPIPE, SIG_IGN);
+    size_t next_index = 0;
+    auto assign = [&](Worker* worker) {
+        worker->is_busy = false;
+        if (next_index < primes.size()) {
+            uint64_t index = next_index;
+            if (write_exactly(worker->task_fd, &index, sizeof(index))) {
+                worker->is_busy = true;
+                ++next_index;
+            }
+        }
+    };
+    for (auto& worker : workers) {
+        assign(&worker);
+    }
+    while (true) {
+        std::vector<pollfd> fds;
+        std::vector<Worker*> polled;
+        for (auto& worker : workers) {
+            if (worker.is_busy) {
+                fds.push_back({worker.result_fd, POLLIN, 0});
+                polled.push_back(&worker);
+            }
+        }
+        if (fds.empty()) {
+            break;
+        }
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // the results can't be waited for any more, the current primes of the workers stay invalid
+            for (auto* worker : polled) {
+                worker->is_busy = false;
+            }
+            break;
+        }
+        for (size_t i = 0; i < fds.size(); ++i) {
+            if (fds[i].revents == 0) {
+                continue;
+            }
+            // frame: index, payload size, payload
+            uint64_t header[2];
+            std::string payload;
+            bool is_read = read_exactly(polled[i]->result_fd, header, sizeof(header)) && header[0] < primes.size();
+            if (is_read) {
+                payload.resize(header[1]);
+                is_read = read_exactly(polled[i]->result_fd, payload.data(), payload.size());
+            }
+            if (!is_read) {
+                // the worker died, its current prime stays invalid
+                polled[i]->is_busy = false;
+                continue;
+            }
+            auto& image = images[header[0]];
+            if (!payload.empty()) {
+                PrimeField field(image.prime);
+                DynModular::FieldScope scope(field);
+                std::istringstream in(payload);
+                try {
+                    image.basis = Serializer<PolynomialSet<DynModular>>::read(in);
+                    image.is_valid = true;
+                } catch (const std::exception&) {
+                    image.is_valid = false;
+                }
+            }
+            assign(polled[i]);
+        }
+    }
+    for (auto& worker : workers) {
+        close(worker.task_fd);
+        close(worker.result_fd);
+        waitpid(worker.pid, nullptr, 0);
+    }
+    signal(SIGPIPE, previous_handler);
+    return images;
+}
+
+template<class Order>
+bool MultiPrime::combine(const std::vector<PrimeImage>& images, PolynomialSet<Integer>* result, Integer* modulus) {
+    // sorted leading monomials of every valid image, the most frequent ones are the lucky ones
+    std::vector<std::pair<std::vector<Monomial>, size_t>> leads;
+    std::vector<size_t> group(images.size());
+    for (size_t i = 0; i < images.size(); ++i) {
+        if (!images[i].is_valid) {
+            continue;
+        }
+        std::vector<Monomial> monomials;
+        for (const auto& f : images[i].basis) {
+            monomials.push_back(Algorithm::get_leading_term<Order>(f).first);
+        }
+        std::sort(monomials.begin(), monomials.end(), Order());
+        auto it = std::find_if(leads.begin(), leads.end(), [&](const auto& entry) { return entry.first == monomials; });
+        if (it == leads.end()) {
+            leads.emplace_back(std::move(monomials), 0);
+            it = std::prev(leads.end());
+        }
+        ++it->second;
+        group[i] = it - leads.begin();
+    }
+    if (leads.empty()) {
+        return false;
+    }
+    size_t lucky_group = std::max_element(leads.begin(), leads.end(), [](const auto& a, const auto& b) {
+        return a.second < b.second;
+    }) - leads.begin();
+    const auto& lucky_leads = leads[lucky_group].first;
+
+    // polynomials are matched by their leading monomials, every lucky image has the same ones
+    std::vector<Polynomial<Integer>> combined(lucky_leads.size());
+    *modulus = 1;
+    for (size_t i = 0; i < images.size(); ++i) {
+        if (!images[i].is_valid || group[i] != lucky_group) {
+            continue;
+        }
+        Integer prime = images[i].prime;
+        // x = a (mod M), x = b (mod p): x = a + M * ((b - a) / M mod p)
+        Integer inverse = boost::multiprecision::powm(Integer(*modulus % prime), prime - 2, prime);
+        for (const auto& f : images[i].basis) {
+            auto lead = Algorithm::get_leading_term<Order>(f).first;
+            auto& g = combined[std::lower_bound(lucky_leads.begin(), lucky_leads.end(), lead, Order()) -
+                               lucky_leads.begin()];
+            Polynomial<Integer> updated;
+            auto update = [&](const Monomial& monomial, const Integer& a, const Integer& b) {
+                Integer difference = (b - a % prime) % prime;
+                if (difference < 0) {
+                    difference += prime;
+                }
+                updated.add_monomial(monomial, a + *modulus * (difference * inverse % prime));
+            };
+            for (const auto& [monomial, coefficient] : g) {
+                update(monomial, coefficient, f.get_coefficient(monomial).get_value());
+            }
+            for (const auto& [monomial, coefficient] : f) {
+                if (g.get_coefficient(monomial) == 0) {
+                    update(monomial, 0, coefficient.get_value());
+                }
+            }
+            g = std::move(updated);
+        }
+        *modulus *= prime;
+    }
+    result->clear();
+    for (auto& g : combined) {
+        result->insert(std::move(g));
+    }
+    return true;
+}
+
+bool MultiPrime::reconstruct(const PolynomialSet<Integer>& F, const Integer& modulus, PolynomialSet<Rational>* result) {
+    PolynomialSet<Rational> reconstructed;
+    for (const auto& f : F) {
+        Polynomial<Rational> g;
+        for (const auto& [monomial, coefficient] : f) {
+            Rational value;
+            if (!reconstruct(coefficient, modulus, &value)) {
+                return false;
+            }
+            g.add_monomial(monomial, value);
+        }
+        reconstructed.insert(std::move(g));
+    }
+    *result = std::move(reconstructed);
+    return true;
+}
+
+template<class IntType>
+bool MultiPrime::get_image(const boost::rational<IntType>& value, DynModular* result) {
+    auto denominator = get_residue(value.denominator());
+    if (denominator == DynModular(0)) {
+        return false;
+    }
+    *result = get_residue(value.numerator()) / denominator;
+    return true;
+}
+
+bool MultiPrime::get_image(const HybridRational& value, DynModular* result) {
+    if (value.is_small()) {
+        return get_image(boost::rational<long long>(value.get_small_numerator(), value.get_small_denominator()),
+                         result);
+    }
+    return get_image(value.get_big(), result);
+}
+
+template<class IntType>
+bool MultiPrime::get_image(const IntType& value, DynModular* result) {
+    *result = get_residue(value);
+    return true;
+}
+
+template<class ValueType>
+bool MultiPrime::get_image(const PolynomialSet<ValueType>& F, PolynomialSet<DynModular>* result) {
+    result->clear();
+    for (const auto& f : F) {
+        Polynomial<DynModular> image;
+        for (const auto& [monomial, coefficient] : f) {
+            DynModular value;
+            if (!get_image(coefficient, &value)) {
+                return false;
+            }
+            image.add_monomial(monomial, value);
+        }
+        if (!image.is_zero()) {
+            result->insert(std::move(image));
+        }
+    }
+    return true;
+}
+
+
+void MultiPrime::check_primes(const std::vector<long long>& primes) {
+    auto sorted = primes;
+    std::sort(sorted.begin(), sorted.end());
+    if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+        throw std::invalid_argument("MultiPrime: duplicate primes");
+    }
+}
+
+template<class Order, class ValueType>
+PrimeImage MultiPrime::compute_image(const PolynomialSet<ValueType>& F, long long prime) {
+    PrimeImage image;
+    image.prime = prime;
+    PrimeField field(prime);
+    DynModular::FieldScope scope(field);
+    if (get_image(F, &image.basis)) {
+        Algorithm::extend_to_grobners_basis<Order>(&image.basis);
+        image.is_valid = true;
+    }
+    return image;
+}
+
+template<class IntType>
+DynModular MultiPrime::get_residue(const IntType& value) {
+    auto modulus = DynModular::get_field().get_modulus();
+    if constexpr (std::is_integral_v<IntType>) {
+        return DynModular(static_cast<DynModular::ValueType>(value % modulus));
+    } else {
+        return DynModular(static_cast<DynModular::ValueType>(IntType(value % modulus)));
+    }
+}
+
+bool MultiPrime::reconstruct(const Integer& value, const Integer& modulus, Rational* result) {
+    // extended Euclid on (modulus, value) stopped at the first remainder below sqrt(modulus / 2)
+    Integer bound = boost::multiprecision::sqrt(Integer(modulus / 2));
+    Integer r0 = modulus, r1 = value % modulus;
+    Integer s0 = 0, s1 = 1;
+    while (r1 > bound) {
+        Integer quotient = r0 / r1;
+        r0 -= quotient * r1;
+        std::swap(r0, r1);
+        s0 -= quotient * s1;
+        std::swap(s0, s1);
+    }
+    if (s1 == 0 || abs(s1) > bound || boost::multiprecision::gcd(r1, s1) != 1) {
+        return false;
+    }
+    // boost::rational<cpp_int> rejects negative denominators
+    if (s1 < 0) {
+        r1 = -r1;
+        s1 = -s1;
+    }
+    *result = Rational(r1, s1);
+    return true;
+}
+
+template<class Order, class ValueType>
+void MultiPrime::run_worker(const PolynomialSet<ValueType>& F, const std::vector<long long>& primes, int task_fd,
+                            int result_fd) {
+    uint64_t index;
+    while (read_exactly(task_fd, &index, sizeof(index)) && index < primes.size()) {
+        std::string payload;
+        try {
+            auto image = compute_image<Order>(F, primes[index]);
+            if (image.is_valid) {
+                std::ostringstream out;
+                Serializer<PolynomialSet<DynModular>>::write(out, image.basis);
+                payload = out.str();
+            }
+        } catch (const std::exception&) {
+            payload.clear();
+        }
+        uint64_t header[2] = {index, payload.size()};
+        if (!write_exactly(result_fd, header, sizeof(header)) ||
+                !write_exactly(result_fd, payload.data(), payload.size())) {
+            return;
+        }
+    }
+}
+
+bool MultiPrime::read_exactly(int fd, void* data, size_t size) {
+    auto* bytes = static_cast<char*>(data);
+    while (size > 0) {
+        auto count = read(fd, bytes, size);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        bytes += count;
+        size -= count;
+    }
+    return true;
+}
+
+bool MultiPrime::write_exactly(int fd, const void* data, size_t size) {
+    const auto* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        auto count = write(fd, bytes, size);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        bytes += count;
+        size -= count;
+    }
+    return true;
+}
+
+}  // grobner
+
+#endif  // GROBNER_MULTI_PRIME_H_
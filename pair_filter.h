@@ -0,0 +1,29 @@
+#ifndef GROBNER_PAIR_FILTER_H_
+#define GROBNER_PAIR_FILTER_H_
+
+#include "declarations.h"
+
+namespace grobner {
+
+// Algorithm asks a pair filter whether an S-polynomial can be dropped without reducing it.
+// NoPairFilter never drops anything and is optimized away; see ModularPairFilter for a real one.
+class NoPairFilter {
+  public:
+    // F is the current basis, called every time it changes
+    template<class Order, class ValueType, class MonomialType>
+    void set_basis(const PolynomialSet<ValueType, MonomialType>&) {}
+
+    // true if S (not reduced yet) may be treated as reducing to zero modulo the basis
+    template<class Order, class ValueType, class MonomialType>
+    bool is_reduced_to_zero(const Polynomial<ValueType, MonomialType>&) {
+        return false;
+    }
+
+    // result of the exact reduction of an S-polynomial that was not dropped
+    template<class ValueType, class MonomialType>
+    void on_reduction_finished(const Polynomial<ValueType, MonomialType>&) {}
+};
+
+}  // grobner
+
+#endif  // GROBNER_PAIR_FILTER_H_
@@ -10,12 +10,13 @@ class PairSetIterator {
   public:
     PairSetIterator(ElemIt first, ElemIt second, ElemIt c_begin, ElemIt c_end);
 
-    PairSetIterator<ElemIt> operator++();
+    PairSetIterator<ElemIt>& operator++();
 
-    auto operator * ();
+    // references to the elements of the set, valid while they are in it
+    std::pair<decltype(*std::declval<ElemIt>()), decltype(*std::declval<ElemIt>())> operator * () const;
 
-    auto first();
-    auto second();
+    decltype(auto) first() const;
+    decltype(auto) second() const;
 
     bool operator != (const PairSetIterator& other);
 
@@ -36,7 +37,7 @@ PairSetIterator<ElemIt>::PairSetIterator(ElemIt first, ElemIt second, ElemIt c_b
 }
 
 template<class ElemIt>
-PairSetIterator<ElemIt> PairSetIterator<ElemIt>::operator++() {
+PairSetIterator<ElemIt>& PairSetIterator<ElemIt>::operator++() {
     ++second_;
     if (first_ == second_) {
         ++first_;
@@ -46,17 +47,18 @@ PairSetIterator<ElemIt> PairSetIterator<ElemIt>::operator++() {
 }
 
 template<class ElemIt>
-auto PairSetIterator<ElemIt>::operator * () {
-    return std::make_pair(*first_, *second_);
+std::pair<decltype(*std::declval<ElemIt>()), decltype(*std::declval<ElemIt>())>
+PairSetIterator<ElemIt>::operator * () const {
+    return {*first_, *second_};
 }
 
 template<class ElemIt>
-auto PairSetIterator<ElemIt>::first() {
+decltype(auto) PairSetIterator<ElemIt>::first() const {
     return *first_;
 }
 
 template<class ElemIt>
-auto PairSetIterator<ElemIt>::second() {
+decltype(auto) PairSetIterator<ElemIt>::second() const {
     return *second_;
 }
 
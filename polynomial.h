@@ -6,27 +6,30 @@
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "declarations.h"
 #include "hashes.h"
 #include "monomial.h"
+#include "monomial_order.h"
 
 namespace grobner {
 
-template<class ValueType>
+template<class ValueType, class MonomialType>
 class Polynomial {
   public:
-    using Containter = std::unordered_map<Monomial, ValueType, grobner::hash<Monomial>>;
+    using Containter = std::unordered_map<MonomialType, ValueType, grobner::hash<MonomialType>>;
     using iterator = typename Containter::iterator;
     using const_iterator = typename Containter::const_iterator;
 
     Polynomial();
-    Polynomial(Monomial monomial);
+    Polynomial(MonomialType monomial);
     Polynomial(ValueType value);
     Polynomial(std::string s);
     Polynomial(const char* c);
 
-    void add_monomial(const Monomial& monomial, ValueType coefficient = ValueType(1));
+    void add_monomial(const MonomialType& monomial, ValueType coefficient = ValueType(1));
 
     iterator begin();
     iterator end();
@@ -35,9 +38,12 @@ class Polynomial {
 
     bool is_zero() const;
     void set_to_zero();
+    size_t size() const;
+    // zero if there is no such term
+    ValueType get_coefficient(const MonomialType& monomial) const;
 
     template<class MonomialOrder>
-    std::vector<Monomial> get_monomials_sorted(const MonomialOrder& monomial_order) const;
+    std::vector<MonomialType> get_monomials_sorted(const MonomialOrder& monomial_order) const;
 
     friend Polynomial& operator += (Polynomial& first, const Polynomial& second) {
         for (const auto& [monomial, coefficient] : second) {
@@ -47,7 +53,12 @@ class Polynomial {
     }
     friend Polynomial operator + (const Polynomial& first, const Polynomial& second) {
         auto result = first;
-        return result += second;
+        result += second;
+        return result;
+    }
+    friend Polynomial operator + (Polynomial&& first, const Polynomial& second) {
+        first += second;
+        return std::move(first);
     }
     friend Polynomial& operator -= (Polynomial& first, const Polynomial& second) {
         for (const auto& [monomial, coefficient] : second) {
@@ -57,20 +68,27 @@ class Polynomial {
     }
     friend Polynomial operator - (const Polynomial& first, const Polynomial& second) {
         auto result = first;
-        return result -= second;
+        result -= second;
+        return result;
+    }
+    friend Polynomial operator - (Polynomial&& first, const Polynomial& second) {
+        first -= second;
+        return std::move(first);
     }
 
-    friend Polynomial& operator *= (Polynomial& first, const Monomial& second) {
-        first = first * second;
+    friend Polynomial& operator *= (Polynomial& first, const MonomialType& second) {
+        first.shift_by(second);
         return first;
     }
-    friend Polynomial operator * (const Polynomial& first, const Monomial& second) {
-        Polynomial result;
-        for (const auto& [monomial, coefficient] : first) {
-            result.add_monomial(monomial * second, coefficient);
-        }
+    friend Polynomial operator * (const Polynomial& first, const MonomialType& second) {
+        auto result = first;
+        result *= second;
         return result;
     }
+    friend Polynomial operator * (Polynomial&& first, const MonomialType& second) {
+        first *= second;
+        return std::move(first);
+    }
     friend Polynomial& operator *= (Polynomial& first, const ValueType& second) {
         if (second == ValueType(0)) {
             first.set_to_zero();
@@ -83,31 +101,34 @@ class Polynomial {
     }
     friend Polynomial operator * (const Polynomial& first, const ValueType& second) {
         auto result = first;
-        return result *= second;
+        result *= second;
+        return result;
+    }
+    friend Polynomial operator * (Polynomial&& first, const ValueType& second) {
+        first *= second;
+        return std::move(first);
     }
     friend Polynomial& operator *= (Polynomial& first, const Polynomial& second) {
         first = first * second;
         return first;
     }
     friend Polynomial operator * (const Polynomial& first, const Polynomial& second) {
-        Polynomial result;
-        for (const auto& [monomial, coefficient] : second) {
-            result += first * monomial * coefficient;
-        }
-        return result;
+        return get_product(first, second);
     }
 
-    friend Polynomial& operator /= (Polynomial& first, const Monomial& second) {
-        first = first / second;
+    friend Polynomial& operator /= (Polynomial& first, const MonomialType& second) {
+        first.shift_by(MonomialType() / second);
         return first;
     }
-    friend Polynomial operator / (const Polynomial& first, const Monomial& second) {
-        Polynomial result;
-        for (const auto& [monomial, coefficient] : first) {
-            result.add_monomial(monomial / second, coefficient);
-        }
+    friend Polynomial operator / (const Polynomial& first, const MonomialType& second) {
+        auto result = first;
+        result /= second;
         return result;
     }
+    friend Polynomial operator / (Polynomial&& first, const MonomialType& second) {
+        first /= second;
+        return std::move(first);
+    }
     friend Polynomial& operator /= (Polynomial& first, const ValueType& second) {
         for (auto& [monomial, coefficient] : first) {
             coefficient /= second;
@@ -116,7 +137,12 @@ class Polynomial {
     }
     friend Polynomial operator / (const Polynomial& first, const ValueType& second) {
         auto result = first;
-        return result /= second;
+        result /= second;
+        return result;
+    }
+    friend Polynomial operator / (Polynomial&& first, const ValueType& second) {
+        first /= second;
+        return std::move(first);
     }
 
     friend bool operator == (const Polynomial& first, const Polynomial& second) {
@@ -126,90 +152,116 @@ class Polynomial {
         return !(first == second);
     }
 
-    template<class OtherValueType>
-    friend std::ostream& operator << (std::ostream& out, const Polynomial<OtherValueType>& polynomial);
+    template<class OtherValueType, class OtherMonomialType>
+    friend std::ostream& operator << (std::ostream& out, const Polynomial<OtherValueType, OtherMonomialType>& polynomial);
 
   private:
     std::string to_string(const ValueType& value) const;
     void remove_zero_coefficients();
 
+    // Johnson's algorithm: the streams first[i] * second are merged with a heap in decreasing
+    // lex order, so the terms of the product come out sorted and equal monomials are combined
+    // immediately, without temporary polynomials
+    static Polynomial get_product(const Polynomial& first, const Polynomial& second);
+    // multiplies every monomial by the given one; multiplication is injective, so the nodes
+    // are moved to the new table as they are, without merging or allocating
+    void shift_by(const MonomialType& monomial);
+
     Containter data_;
 };
 
-template<class ValueType>
-Polynomial<ValueType>::Polynomial() {}
+template<class ValueType, class MonomialType>
+Polynomial<ValueType, MonomialType>::Polynomial() {}
 
-template<class ValueType>
-Polynomial<ValueType>::Polynomial(Monomial monomial) {
+template<class ValueType, class MonomialType>
+Polynomial<ValueType, MonomialType>::Polynomial(MonomialType monomial) {
     data_.emplace(monomial, 1);
 }
 
-template<class ValueType>
-Polynomial<ValueType>::Polynomial(ValueType value) {
+template<class ValueType, class MonomialType>
+Polynomial<ValueType, MonomialType>::Polynomial(ValueType value) {
     if (value != ValueType(0)) {
-        data_[Monomial()] = value;
+        data_[MonomialType()] = value;
     }
 }
 
-template<class ValueType>
-Polynomial<ValueType>::Polynomial(std::string s) {
+template<class ValueType, class MonomialType>
+Polynomial<ValueType, MonomialType>::Polynomial(std::string s) {
     std::stringstream ss(s);
     ValueType coefficient;
     while (ss >> coefficient) {
-        Monomial monomial;
+        MonomialType monomial;
         monomial.read(ss);
         data_[monomial] += coefficient;
     }
     remove_zero_coefficients();
 }
 
-template<class ValueType>
-Polynomial<ValueType>::Polynomial(const char* c) : Polynomial(std::string(c)) {}
+template<class ValueType, class MonomialType>
+Polynomial<ValueType, MonomialType>::Polynomial(const char* c) : Polynomial(std::string(c)) {}
 
-template<class ValueType>
-void Polynomial<ValueType>::add_monomial(const Monomial& monomial, ValueType coefficient) {
-    data_[monomial] += coefficient;
-    if (data_[monomial] == ValueType(0)) {
-        data_.erase(monomial);
+template<class ValueType, class MonomialType>
+void Polynomial<ValueType, MonomialType>::add_monomial(const MonomialType& monomial, ValueType coefficient) {
+    auto it = data_.find(monomial);
+    if (it == data_.end()) {
+        if (coefficient != ValueType(0)) {
+            data_.emplace(monomial, std::move(coefficient));
+        }
+        return;
+    }
+    it->second += coefficient;
+    if (it->second == ValueType(0)) {
+        data_.erase(it);
     }
 }
 
 
-template<class ValueType>
-typename Polynomial<ValueType>::iterator Polynomial<ValueType>::begin() {
+template<class ValueType, class MonomialType>
+typename Polynomial<ValueType, MonomialType>::iterator Polynomial<ValueType, MonomialType>::begin() {
     return data_.begin();
 }
 
-template<class ValueType>
-typename Polynomial<ValueType>::iterator Polynomial<ValueType>::end() {
+template<class ValueType, class MonomialType>
+typename Polynomial<ValueType, MonomialType>::iterator Polynomial<ValueType, MonomialType>::end() {
     return data_.end();
 }
 
-template<class ValueType>
-typename Polynomial<ValueType>::const_iterator Polynomial<ValueType>::begin() const {
+template<class ValueType, class MonomialType>
+typename Polynomial<ValueType, MonomialType>::const_iterator Polynomial<ValueType, MonomialType>::begin() const {
     return data_.begin();
 }
 
-template<class ValueType>
-typename Polynomial<ValueType>::const_iterator Polynomial<ValueType>::end() const {
+template<class ValueType, class MonomialType>
+typename Polynomial<ValueType, MonomialType>::const_iterator Polynomial<ValueType, MonomialType>::end() const {
     return data_.end();
 }
 
-template<class ValueType>
-bool Polynomial<ValueType>::is_zero() const {
+template<class ValueType, class MonomialType>
+bool Polynomial<ValueType, MonomialType>::is_zero() const {
     return data_.empty();
 }
 
-template<class ValueType>
-void Polynomial<ValueType>::set_to_zero() {
+template<class ValueType, class MonomialType>
+void Polynomial<ValueType, MonomialType>::set_to_zero() {
     data_.clear();
 }
 
+template<class ValueType, class MonomialType>
+size_t Polynomial<ValueType, MonomialType>::size() const {
+    return data_.size();
+}
+
+template<class ValueType, class MonomialType>
+ValueType Polynomial<ValueType, MonomialType>::get_coefficient(const MonomialType& monomial) const {
+    auto it = data_.find(monomial);
+    return it == data_.end() ? ValueType(0) : it->second;
+}
 
-template<class ValueType>
+
+template<class ValueType, class MonomialType>
 template<class MonomialOrder>
-std::vector<Monomial> Polynomial<ValueType>::get_monomials_sorted(const MonomialOrder& monomial_order) const {
-    std::vector<Monomial> monomials;
+std::vector<MonomialType> Polynomial<ValueType, MonomialType>::get_monomials_sorted(const MonomialOrder& monomial_order) const {
+    std::vector<MonomialType> monomials;
     monomials.reserve(data_.size());
     for (const auto& [monomial, coefficient] : data_) {
         monomials.push_back(monomial);
@@ -219,8 +271,8 @@ std::vector<Monomial> Polynomial<ValueType>::get_monomials_sorted(const Monomial
 }
 
 
-template<class ValueType>
-std::ostream& operator << (std::ostream& out, const Polynomial<ValueType>& polynomial) {
+template<class ValueType, class MonomialType>
+std::ostream& operator << (std::ostream& out, const Polynomial<ValueType, MonomialType>& polynomial) {
     if (polynomial.is_zero()) {
         return out << ValueType(0);
     }
@@ -237,15 +289,15 @@ std::ostream& operator << (std::ostream& out, const Polynomial<ValueType>& polyn
 }
 
 
-template<class ValueType>
-std::string Polynomial<ValueType>::to_string(const ValueType& value) const {
+template<class ValueType, class MonomialType>
+std::string Polynomial<ValueType, MonomialType>::to_string(const ValueType& value) const {
     std::stringstream ss;
     ss << value;
     return ss.str();
 }
 
-template<class ValueType>
-void Polynomial<ValueType>::remove_zero_coefficients() {
+template<class ValueType, class MonomialType>
+void Polynomial<ValueType, MonomialType>::remove_zero_coefficients() {
     auto it = data_.begin();
     while (it != data_.end()) {
         auto it_next = it;
@@ -257,6 +309,93 @@ void Polynomial<ValueType>::remove_zero_coefficients() {
     }
 }
 
+template<class ValueType, class MonomialType>
+Polynomial<ValueType, MonomialType> Polynomial<ValueType, MonomialType>::get_product(const Polynomial& first, const Polynomial& second) {
+    if (first.size() > second.size()) {
+        // the heap has one entry per term of the first polynomial
+        return get_product(second, first);
+    }
+    if (first.is_zero()) {
+        return Polynomial();
+    }
+
+    using Term = std::pair<const MonomialType*, const ValueType*>;
+    auto get_terms_sorted = [](const Polynomial& polynomial) {
+        std::vector<Term> terms;
+        terms.reserve(polynomial.size());
+        for (const auto& [monomial, coefficient] : polynomial.data_) {
+            terms.emplace_back(&monomial, &coefficient);
+        }
+        std::sort(terms.begin(), terms.end(), [](const Term& a, const Term& b) {
+            return LexOrder::cmp(*a.first, *b.first) > 0;
+        });
+        return terms;
+    };
+    auto first_terms = get_terms_sorted(first);
+    auto second_terms = get_terms_sorted(second);
+
+    struct HeapEntry {
+        MonomialType monomial;
+        size_t first_index;
+        size_t second_index;
+    };
+    auto is_less = [](const HeapEntry& a, const HeapEntry& b) {
+        return LexOrder::cmp(a.monomial, b.monomial) < 0;
+    };
+    std::vector<HeapEntry> heap;
+    heap.reserve(first_terms.size());
+    for (size_t i = 0; i < first_terms.size(); ++i) {
+        heap.push_back({*first_terms[i].first * *second_terms[0].first, i, 0});
+    }
+    std::make_heap(heap.begin(), heap.end(), is_less);
+
+    std::vector<std::pair<MonomialType, ValueType>> terms;
+    terms.reserve(first_terms.size() + second_terms.size());
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), is_less);
+        auto& top = heap.back();
+        auto coefficient = *first_terms[top.first_index].second * *second_terms[top.second_index].second;
+        if (!terms.empty() && terms.back().first == top.monomial) {
+            terms.back().second += coefficient;
+        } else {
+            if (!terms.empty() && terms.back().second == ValueType(0)) {
+                terms.pop_back();
+            }
+            terms.emplace_back(top.monomial, std::move(coefficient));
+        }
+        if (++top.second_index < second_terms.size()) {
+            // reuses the memory of top.monomial
+            top.monomial = *first_terms[top.first_index].first;
+            top.monomial *= *second_terms[top.second_index].first;
+            std::push_heap(heap.begin(), heap.end(), is_less);
+        } else {
+            heap.pop_back();
+        }
+    }
+    if (!terms.empty() && terms.back().second == ValueType(0)) {
+        terms.pop_back();
+    }
+
+    Polynomial result;
+    result.data_.reserve(terms.size());
+    for (auto& [monomial, coefficient] : terms) {
+        result.data_.emplace(std::move(monomial), std::move(coefficient));
+    }
+    return result;
+}
+
+template<class ValueType, class MonomialType>
+void Polynomial<ValueType, MonomialType>::shift_by(const MonomialType& monomial) {
+    Containter result;
+    result.reserve(data_.size());
+    while (!data_.empty()) {
+        auto node = data_.extract(data_.begin());
+        node.key() *= monomial;
+        result.insert(std::move(node));
+    }
+    data_.swap(result);
+}
+
 }  // grobner
 
 #endif  // GROBNER_POLYNOMIAL_H_
@@ -0,0 +1,276 @@
+#ifndef GROBNER_POLYNOMIAL_BASIS_H_
+#define GROBNER_POLYNOMIAL_BASIS_H_
+
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "hashes.h"
+#include "polynomial.h"
+#include "polynomial_set.h"
+
+namespace grobner {
+
+// Polynomials indexed by stable integer ids: an id is assigned on insertion and never
+// reused, erasing leaves a tombstone. Unlike PolynomialSet, inserting and erasing doesn't
+// hash the polynomial; with fingerprints enabled it is hashed once on insertion, which
+// allows finding and skipping duplicates.
+template<class ValueType, class MonomialType>
+class PolynomialBasis {
+  public:
+    using Polynomial = grobner::Polynomial<ValueType, MonomialType>;
+    using Id = size_t;
+
+    static constexpr Id kNoId = std::numeric_limits<Id>::max();
+
+    class const_iterator {
+      public:
+        const_iterator(const PolynomialBasis* basis, Id id);
+
+        const Polynomial& operator * () const;
+        const Polynomial* operator -> () const;
+        const_iterator& operator ++ ();
+        bool operator == (const const_iterator& other) const;
+        bool operator != (const const_iterator& other) const;
+
+        Id get_id() const;
+
+      private:
+        void skip_erased();
+
+        const PolynomialBasis* basis_;
+        Id id_;
+    };
+
+    explicit PolynomialBasis(bool use_fingerprints = false);
+    explicit PolynomialBasis(const PolynomialSet<ValueType, MonomialType>& set, bool use_fingerprints = false);
+
+    // with fingerprints, returns the id of an equal polynomial if there is one
+    Id insert(Polynomial polynomial);
+    void erase(Id id);
+    // erases and moves the polynomial out
+    Polynomial extract(Id id);
+
+    const Polynomial& operator [] (Id id) const;
+    bool contains(Id id) const;
+    // requires fingerprints, kNoId if not found
+    Id find(const Polynomial& polynomial) const;
+
+    // number of polynomials that are not erased
+    size_t size() const;
+    bool empty() const;
+    // all ids ever assigned are less than this
+    Id get_id_limit() const;
+    std::vector<Id> get_ids() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    PolynomialSet<ValueType, MonomialType> to_set() &&;
+
+  private:
+    size_t get_fingerprint(const Polynomial& polynomial) const;
+    void remove_fingerprint(Id id);
+
+    std::vector<Polynomial> polynomials_;
+    std::vector<bool> is_erased_;
+    size_t size_ = 0;
+
+    bool use_fingerprints_;
+    std::vector<size_t> fingerprints_;
+    std::unordered_multimap<size_t, Id> ids_by_fingerprint_;
+};
+
+
+template<class ValueType, class MonomialType>
+PolynomialBasis<ValueType, MonomialType>::const_iterator::const_iterator(const PolynomialBasis* basis, Id id) :
+    basis_(basis),
+    id_(id) {
+    skip_erased();
+}
+
+template<class ValueType, class MonomialType>
+const typename PolynomialBasis<ValueType, MonomialType>::Polynomial& PolynomialBasis<ValueType, MonomialType>::const_iterator::operator * () const {
+    return basis_->polynomials_[id_];
+}
+
+template<class ValueType, class MonomialType>
+const typename PolynomialBasis<ValueType, MonomialType>::Polynomial* PolynomialBasis<ValueType, MonomialType>::const_iterator::operator -> () const {
+    return &basis_->polynomials_[id_];
+}
+
+template<class ValueType, class MonomialType>
+typename PolynomialBasis<ValueType, MonomialType>::const_iterator& PolynomialBasis<ValueType, MonomialType>::const_iterator::operator ++ () {
+    ++id_;
+    skip_erased();
+    return *this;
+}
+
+template<class ValueType, class MonomialType>
+bool PolynomialBasis<ValueType, MonomialType>::const_iterator::operator == (const const_iterator& other) const {
+    return id_ == other.id_;
+}
+
+template<class ValueType, class MonomialType>
+bool PolynomialBasis<ValueType, MonomialType>::const_iterator::operator != (const const_iterator& other) const {
+    return !(*this == other);
+}
+
+template<class ValueType, class MonomialType>
+typename PolynomialBasis<ValueType, MonomialType>::Id PolynomialBasis<ValueType, MonomialType>::const_iterator::get_id() const {
+    return id_;
+}
+
+template<class ValueType, class MonomialType>
+void PolynomialBasis<ValueType, MonomialType>::const_iterator::skip_erased() {
+    while (id_ < basis_->get_id_limit() && basis_->is_erased_[id_]) {
+        ++id_;
+    }
+}
+
+
+template<class ValueType, class MonomialType>
+PolynomialBasis<ValueType, MonomialType>::PolynomialBasis(bool use_fingerprints) : use_fingerprints_(use_fingerprints) {}
+
+template<class ValueType, class MonomialType>
+PolynomialBasis<ValueType, MonomialType>::PolynomialBasis(const PolynomialSet<ValueType, MonomialType>& set, bool use_fingerprints) :
+    use_fingerprints_(use_fingerprints) {
+    polynomials_.reserve(set.size());
+    is_erased_.reserve(set.size());
+    for (const auto& polynomial : set) {
+        insert(polynomial);
+    }
+}
+
+template<class ValueType, class MonomialType>
+typename PolynomialBasis<ValueType, MonomialType>::Id PolynomialBasis<ValueType, MonomialType>::insert(Polynomial polynomial) {
+    if (use_fingerprints_) {
+        auto fingerprint = get_fingerprint(polynomial);
+        auto [range_begin, range_end] = ids_by_fingerprint_.equal_range(fingerprint);
+        for (auto it = range_begin; it != range_end; ++it) {
+            if (polynomials_[it->second] == polynomial) {
+                return it->second;
+            }
+        }
+        ids_by_fingerprint_.emplace(fingerprint, polynomials_.size());
+        fingerprints_.push_back(fingerprint);
+    }
+    polynomials_.push_back(std::move(polynomial));
+    is_erased_.push_back(false);
+    ++size_;
+    return polynomials_.size() - 1;
+}
+
+template<class ValueType, class MonomialType>
+void PolynomialBasis<ValueType, MonomialType>::erase(Id id) {
+    extract(id);
+}
+
+template<class ValueType, class MonomialType>
+typename PolynomialBasis<ValueType, MonomialType>::Polynomial PolynomialBasis<ValueType, MonomialType>::extract(Id id) {
+    assert(contains(id));
+    if (use_fingerprints_) {
+        remove_fingerprint(id);
+    }
+    is_erased_[id] = true;
+    --size_;
+    return std::move(polynomials_[id]);
+}
+
+template<class ValueType, class MonomialType>
+const typename PolynomialBasis<ValueType, MonomialType>::Polynomial& PolynomialBasis<ValueType, MonomialType>::operator [] (Id id) const {
+    assert(contains(id));
+    return polynomials_[id];
+}
+
+template<class ValueType, class MonomialType>
+bool PolynomialBasis<ValueType, MonomialType>::contains(Id id) const {
+    return id < get_id_limit() && !is_erased_[id];
+}
+
+template<class ValueType, class MonomialType>
+typename PolynomialBasis<ValueType, MonomialType>::Id PolynomialBasis<ValueType, MonomialType>::find(const Polynomial& polynomial) const {
+    assert(use_fingerprints_);
+    auto [range_begin, range_end] = ids_by_fingerprint_.equal_range(get_fingerprint(polynomial));
+    for (auto it = range_begin; it != range_end; ++it) {
+        if (polynomials_[it->second] == polynomial) {
+            return it->second;
+        }
+    }
+    return kNoId;
+}
+
+template<class ValueType, class MonomialType>
+size_t PolynomialBasis<ValueType, MonomialType>::size() const {
+    return size_;
+}
+
+template<class ValueType, class MonomialType>
+bool PolynomialBasis<ValueType, MonomialType>::empty() const {
+    return size_ == 0;
+}
+
+template<class ValueType, class MonomialType>
+typename PolynomialBasis<ValueType, MonomialType>::Id PolynomialBasis<ValueType, MonomialType>::get_id_limit() const {
+    return polynomials_.size();
+}
+
+template<class ValueType, class MonomialType>
+std::vector<typename PolynomialBasis<ValueType, MonomialType>::Id> PolynomialBasis<ValueType, MonomialType>::get_ids() const {
+    std::vector<Id> ids;
+    ids.reserve(size_);
+    for (auto it = begin(); it != end(); ++it) {
+        ids.push_back(it.get_id());
+    }
+    return ids;
+}
+
+template<class ValueType, class MonomialType>
+typename PolynomialBasis<ValueType, MonomialType>::const_iterator PolynomialBasis<ValueType, MonomialType>::begin() const {
+    return const_iterator(this, 0);
+}
+
+template<class ValueType, class MonomialType>
+typename PolynomialBasis<ValueType, MonomialType>::const_iterator PolynomialBasis<ValueType, MonomialType>::end() const {
+    return const_iterator(this, get_id_limit());
+}
+
+template<class ValueType, class MonomialType>
+PolynomialSet<ValueType, MonomialType> PolynomialBasis<ValueType, MonomialType>::to_set() && {
+    PolynomialSet<ValueType, MonomialType> set;
+    for (Id id = 0; id < get_id_limit(); ++id) {
+        if (!is_erased_[id]) {
+            set.insert(std::move(polynomials_[id]));
+        }
+    }
+    polynomials_.clear();
+    is_erased_.clear();
+    fingerprints_.clear();
+    ids_by_fingerprint_.clear();
+    size_ = 0;
+    return set;
+}
+
+
+template<class ValueType, class MonomialType>
+size_t PolynomialBasis<ValueType, MonomialType>::get_fingerprint(const Polynomial& polynomial) const {
+    return hash<Polynomial>()(polynomial);
+}
+
+template<class ValueType, class MonomialType>
+void PolynomialBasis<ValueType, MonomialType>::remove_fingerprint(Id id) {
+    auto [range_begin, range_end] = ids_by_fingerprint_.equal_range(fingerprints_[id]);
+    for (auto it = range_begin; it != range_end; ++it) {
+        if (it->second == id) {
+            ids_by_fingerprint_.erase(it);
+            return;
+        }
+    }
+}
+
+}  // grobner
+
+#endif  // GROBNER_POLYNOMIAL_BASIS_H_
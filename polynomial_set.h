@@ -2,6 +2,7 @@
 #define GROBNER_POLYNOMIAL_SET_H_
 
 #include <unordered_set>
+#include <utility>
 
 #include "declarations.h"
 #include "hashes.h"
@@ -10,10 +11,10 @@
 
 namespace grobner {
 
-template<class ValueType>
+template<class ValueType, class MonomialType>
 class PolynomialSet {
   public:
-    using Polynomial = Polynomial<ValueType>;
+    using Polynomial = grobner::Polynomial<ValueType, MonomialType>;
     using Container = std::unordered_set<Polynomial, grobner::hash<Polynomial>>;
     using iterator = typename Container::iterator;
     using const_iterator = typename Container::const_iterator;
@@ -26,13 +27,21 @@ class PolynomialSet {
     PolynomialSet(std::initializer_list<Polynomial> list);
 
     void insert(const Polynomial& polynomial);
+    void insert(Polynomial&& polynomial);
+    template<class... Args>
+    void emplace(Args&&... args);
     void erase(const Polynomial& polynomial);
     void erase(iterator it);
+    // removes the element and moves it out, without copying
+    Polynomial extract(const_iterator it);
     Polynomial retrieve_first();
     void clear();
     bool empty() const;
     size_t size() const;
 
+    iterator find(const Polynomial& polynomial);
+    const_iterator find(const Polynomial& polynomial) const;
+
     iterator begin();
     iterator end();
     const_iterator begin() const;
@@ -45,89 +54,113 @@ class PolynomialSet {
 };
 
 
-template<class ValueType>
-PolynomialSet<ValueType>::PolynomialSet() {}
+template<class ValueType, class MonomialType>
+PolynomialSet<ValueType, MonomialType>::PolynomialSet() {}
 
-template<class ValueType>
-PolynomialSet<ValueType>::PolynomialSet(std::initializer_list<Polynomial> list) : data_(list) {}
+template<class ValueType, class MonomialType>
+PolynomialSet<ValueType, MonomialType>::PolynomialSet(std::initializer_list<Polynomial> list) : data_(list) {}
 
-template<class ValueType>
-bool PolynomialSet<ValueType>::operator == (const PolynomialSet& other) const {
+template<class ValueType, class MonomialType>
+bool PolynomialSet<ValueType, MonomialType>::operator == (const PolynomialSet& other) const {
     return data_ == other.data_;
 }
 
-template<class ValueType>
-bool PolynomialSet<ValueType>::operator != (const PolynomialSet& other) const {
+template<class ValueType, class MonomialType>
+bool PolynomialSet<ValueType, MonomialType>::operator != (const PolynomialSet& other) const {
     return !(*this == other);
 }
 
-template<class ValueType>
-void PolynomialSet<ValueType>::insert(const Polynomial& polynomial) {
+template<class ValueType, class MonomialType>
+void PolynomialSet<ValueType, MonomialType>::insert(const Polynomial& polynomial) {
     data_.insert(polynomial);
 }
 
-template<class ValueType>
-void PolynomialSet<ValueType>::erase(const Polynomial& polynomial) {
+template<class ValueType, class MonomialType>
+void PolynomialSet<ValueType, MonomialType>::insert(Polynomial&& polynomial) {
+    data_.insert(std::move(polynomial));
+}
+
+template<class ValueType, class MonomialType>
+template<class... Args>
+void PolynomialSet<ValueType, MonomialType>::emplace(Args&&... args) {
+    data_.emplace(std::forward<Args>(args)...);
+}
+
+template<class ValueType, class MonomialType>
+void PolynomialSet<ValueType, MonomialType>::erase(const Polynomial& polynomial) {
     data_.erase(polynomial);
 }
 
-template<class ValueType>
-void PolynomialSet<ValueType>::erase(iterator it) {
+template<class ValueType, class MonomialType>
+void PolynomialSet<ValueType, MonomialType>::erase(iterator it) {
     data_.erase(it);
 }
 
-template<class ValueType>
-typename PolynomialSet<ValueType>::Polynomial PolynomialSet<ValueType>::retrieve_first() {
-    auto result = *begin();
-    erase(begin());
-    return std::move(result);
+template<class ValueType, class MonomialType>
+typename PolynomialSet<ValueType, MonomialType>::Polynomial PolynomialSet<ValueType, MonomialType>::extract(const_iterator it) {
+    return std::move(data_.extract(it).value());
 }
 
-template<class ValueType>
-void PolynomialSet<ValueType>::clear() {
+template<class ValueType, class MonomialType>
+typename PolynomialSet<ValueType, MonomialType>::Polynomial PolynomialSet<ValueType, MonomialType>::retrieve_first() {
+    return extract(begin());
+}
+
+template<class ValueType, class MonomialType>
+void PolynomialSet<ValueType, MonomialType>::clear() {
     data_.clear();
 }
 
-template<class ValueType>
-bool PolynomialSet<ValueType>::empty() const {
+template<class ValueType, class MonomialType>
+bool PolynomialSet<ValueType, MonomialType>::empty() const {
     return data_.empty();
 }
 
-template<class ValueType>
-size_t PolynomialSet<ValueType>::size() const {
+template<class ValueType, class MonomialType>
+size_t PolynomialSet<ValueType, MonomialType>::size() const {
     return data_.size();
 }
 
-template<class ValueType>
-typename PolynomialSet<ValueType>::iterator PolynomialSet<ValueType>::begin() {
+template<class ValueType, class MonomialType>
+typename PolynomialSet<ValueType, MonomialType>::iterator PolynomialSet<ValueType, MonomialType>::find(const Polynomial& polynomial) {
+    return data_.find(polynomial);
+}
+
+template<class ValueType, class MonomialType>
+typename PolynomialSet<ValueType, MonomialType>::const_iterator PolynomialSet<ValueType, MonomialType>::find(const Polynomial& polynomial) const {
+    return data_.find(polynomial);
+}
+
+template<class ValueType, class MonomialType>
+typename PolynomialSet<ValueType, MonomialType>::iterator PolynomialSet<ValueType, MonomialType>::begin() {
     return data_.begin();
 }
 
-template<class ValueType>
-typename PolynomialSet<ValueType>::iterator PolynomialSet<ValueType>::end() {
+template<class ValueType, class MonomialType>
+typename PolynomialSet<ValueType, MonomialType>::iterator PolynomialSet<ValueType, MonomialType>::end() {
     return data_.end();
 }
 
-template<class ValueType>
-typename PolynomialSet<ValueType>::const_iterator PolynomialSet<ValueType>::begin() const {
+template<class ValueType, class MonomialType>
+typename PolynomialSet<ValueType, MonomialType>::const_iterator PolynomialSet<ValueType, MonomialType>::begin() const {
     return data_.begin();
 }
 
-template<class ValueType>
-typename PolynomialSet<ValueType>::const_iterator PolynomialSet<ValueType>::end() const {
+template<class ValueType, class MonomialType>
+typename PolynomialSet<ValueType, MonomialType>::const_iterator PolynomialSet<ValueType, MonomialType>::end() const {
     return data_.end();
 }
 
-template<class ValueType>
-typename PolynomialSet<ValueType>::pair_iterator PolynomialSet<ValueType>::pbegin() {
+template<class ValueType, class MonomialType>
+typename PolynomialSet<ValueType, MonomialType>::pair_iterator PolynomialSet<ValueType, MonomialType>::pbegin() {
     if (empty()) {
         return pend();
     }
     return pair_iterator(++begin(), begin(), begin(), end());
 }
 
-template<class ValueType>
-typename PolynomialSet<ValueType>::pair_iterator PolynomialSet<ValueType>::pend() {
+template<class ValueType, class MonomialType>
+typename PolynomialSet<ValueType, MonomialType>::pair_iterator PolynomialSet<ValueType, MonomialType>::pend() {
     return pair_iterator(end(), begin(), begin(), end());
 }
 
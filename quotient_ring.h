@@ -0,0 +1,217 @@
+#ifndef GROBNER_QUOTIENT_RING_H_
+#define GROBNER_QUOTIENT_RING_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "algorithm.h"
+#include "hashes.h"
+#include "monomial.h"
+#include "polynomial.h"
+#include "polynomial_set.h"
+
+namespace grobner {
+
+// Quotient ring K[x]/I of a zero-dimensional ideal I given by its reduced Grobner basis for
+// Order. The standard monomials (not divisible by any leading monomial) form a basis of it as a
+// vector space, their number is the number of solutions of the system counted with multiplicity,
+// so it can be read off a DegRevLex basis without computing the lex one.
+// Normal forms of non-standard monomials are cached: for m = x_k * m', where m' is not standard,
+// NF(m) is the sum of c * NF(x_k * s) over the terms c * s of NF(m'), and all these monomials
+// are smaller than m; a monomial whose divisors are all standard is a leading monomial of the
+// reduced basis, and its normal form is minus the tail of that element.
+template<class Order, class ValueType>
+class QuotientRing {
+  public:
+    using Polynomial = grobner::Polynomial<ValueType>;
+    // column j is the normal form of x_i * m_j for the standard monomial m_j, as pairs
+    // (index of the standard monomial, coefficient) sorted by index
+    using Column = std::vector<std::pair<size_t, ValueType>>;
+    using Matrix = std::vector<Column>;
+
+    // basis is a reduced Grobner basis for Order, throws std::runtime_error if the ideal is not
+    // zero-dimensional; variable_count is the number of variables of the ring, by default the
+    // largest variable in basis plus one
+    explicit QuotientRing(PolynomialSet<ValueType> basis, size_t variable_count = 0);
+
+    // every variable has a pure power among the leading monomials
+    static bool is_zero_dimensional(const PolynomialSet<ValueType>& basis, size_t variable_count = 0);
+
+    size_t get_variable_count() const;
+    // sorted in Order, 1 is the first one unless the ideal is the whole ring
+    const std::vector<Monomial>& get_standard_monomials() const;
+    // the dimension of the quotient ring
+    size_t get_solution_count() const;
+
+    Polynomial get_normal_form(const Monomial& monomial);
+    Polynomial get_normal_form(Polynomial f) const;
+
+    // matrix of the multiplication by x_variable in the basis of the standard monomials
+    Matrix get_multiplication_matrix(size_t variable);
+
+  private:
+    static size_t get_variable_count(const PolynomialSet<ValueType>& basis);
+
+    void find_standard_monomials();
+    bool is_standard(const Monomial& monomial) const;
+
+    PolynomialSet<ValueType> basis_;
+    size_t variable_count_;
+    std::vector<Monomial> leads_;
+    std::vector<Monomial> standard_monomials_;
+    std::unordered_map<Monomial, size_t, grobner::hash<Monomial>> standard_indices_;
+    // normal forms of non-standard monomials, initially of the leading monomials
+    std::unordered_map<Monomial, Polynomial, grobner::hash<Monomial>> normal_forms_;
+};
+
+
+template<class Order, class ValueType>
+QuotientRing<Order, ValueType>::QuotientRing(PolynomialSet<ValueType> basis, size_t variable_count)
+        : basis_(std::move(basis)),
+          variable_count_(std::max(variable_count, get_variable_count(basis_))) {
+    if (!is_zero_dimensional(basis_, variable_count_)) {
+        throw std::runtime_error("the ideal is not zero-dimensional");
+    }
+    for (const auto& f : basis_) {
+        auto [lead, coefficient] = Algorithm::get_leading_term<Order>(f);
+        normal_forms_.emplace(lead, Polynomial(lead) - f / coefficient);
+        leads_.push_back(std::move(lead));
+    }
+    find_standard_monomials();
+}
+
+template<class Order, class ValueType>
+bool QuotientRing<Order, ValueType>::is_zero_dimensional(const PolynomialSet<ValueType>& basis, size_t variable_count) {
+    variable_count = std::max(variable_count, get_variable_count(basis));
+    std::vector<bool> has_pure_power(variable_count, false);
+    for (const auto& f : basis) {
+        auto lead = Algorithm::get_leading_term<Order>(f).first;
+        if (lead.get_degree() == 0) {
+            return true;
+        }
+        for (size_t i = 0; i < lead.container_size(); ++i) {
+            if (lead.get_degree(i) == lead.get_degree()) {
+                has_pure_power[i] = true;
+            }
+        }
+    }
+    return std::all_of(has_pure_power.begin(), has_pure_power.end(), [](bool value) { return value; });
+}
+
+template<class Order, class ValueType>
+size_t QuotientRing<Order, ValueType>::get_variable_count() const {
+    return variable_count_;
+}
+
+template<class Order, class ValueType>
+const std::vector<Monomial>& QuotientRing<Order, ValueType>::get_standard_monomials() const {
+    return standard_monomials_;
+}
+
+template<class Order, class ValueType>
+size_t QuotientRing<Order, ValueType>::get_solution_count() const {
+    return standard_monomials_.size();
+}
+
+template<class Order, class ValueType>
+typename QuotientRing<Order, ValueType>::Polynomial QuotientRing<Order, ValueType>::get_normal_form(const Monomial& monomial) {
+    if (is_standard(monomial)) {
+        return Polynomial(monomial);
+    }
+    auto it = normal_forms_.find(monomial);
+    if (it != normal_forms_.end()) {
+        return it->second;
+    }
+
+    // not a leading monomial, so some divisor m' = monomial / x_k is not standard
+    Polynomial result;
+    for (size_t k = 0; k < monomial.container_size(); ++k) {
+        if (monomial.get_degree(k) == 0) {
+            continue;
+        }
+        Monomial x;
+        x.set_degree(k, 1);
+        auto divisor = monomial / x;
+        if (is_standard(divisor)) {
+            continue;
+        }
+        for (const auto& [term, coefficient] : get_normal_form(divisor)) {
+            result += get_normal_form(term * x) * coefficient;
+        }
+        break;
+    }
+    normal_forms_.emplace(monomial, result);
+    return result;
+}
+
+template<class Order, class ValueType>
+typename QuotientRing<Order, ValueType>::Polynomial QuotientRing<Order, ValueType>::get_normal_form(Polynomial f) const {
+    Algorithm::reduce_by<Order>(basis_, &f);
+    return f;
+}
+
+template<class Order, class ValueType>
+typename QuotientRing<Order, ValueType>::Matrix QuotientRing<Order, ValueType>::get_multiplication_matrix(size_t variable) {
+    Monomial x;
+    x.set_degree(variable, 1);
+    Matrix matrix(standard_monomials_.size());
+    for (size_t j = 0; j < standard_monomials_.size(); ++j) {
+        for (const auto& [term, coefficient] : get_normal_form(standard_monomials_[j] * x)) {
+            matrix[j].emplace_back(standard_indices_.at(term), coefficient);
+        }
+        std::sort(matrix[j].begin(), matrix[j].end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    }
+    return matrix;
+}
+
+template<class Order, class ValueType>
+size_t QuotientRing<Order, ValueType>::get_variable_count(const PolynomialSet<ValueType>& basis) {
+    size_t result = 0;
+    for (const auto& f : basis) {
+        for (const auto& [monomial, coefficient] : f) {
+            result = std::max(result, monomial.container_size());
+        }
+    }
+    return result;
+}
+
+template<class Order, class ValueType>
+void QuotientRing<Order, ValueType>::find_standard_monomials() {
+    // the standard monomials are closed under division, so every one of them is a standard
+    // monomial multiplied by a variable, or 1
+    std::vector<Monomial> queue;
+    if (is_standard(Monomial())) {
+        queue.push_back(Monomial());
+        standard_indices_.emplace(Monomial(), 0);
+    }
+    for (size_t i = 0; i < queue.size(); ++i) {
+        for (size_t k = 0; k < variable_count_; ++k) {
+            Monomial x;
+            x.set_degree(k, 1);
+            auto monomial = queue[i] * x;
+            if (is_standard(monomial) && standard_indices_.emplace(monomial, 0).second) {
+                queue.push_back(std::move(monomial));
+            }
+        }
+    }
+    std::sort(queue.begin(), queue.end(), Order());
+    standard_monomials_ = std::move(queue);
+    for (size_t i = 0; i < standard_monomials_.size(); ++i) {
+        standard_indices_[standard_monomials_[i]] = i;
+    }
+}
+
+template<class Order, class ValueType>
+bool QuotientRing<Order, ValueType>::is_standard(const Monomial& monomial) const {
+    return std::none_of(leads_.begin(), leads_.end(), [&monomial](const Monomial& lead) {
+        return monomial.is_divisible_by(lead);
+    });
+}
+
+}  // grobner
+
+#endif  // GROBNER_QUOTIENT_RING_H_
@@ -0,0 +1,463 @@
+#ifndef GROBNER_RESULT_CACHE_H_
+#define GROBNER_RESULT_CACHE_H_
+
+#include <boost/rational.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "algorithm.h"
+#include "dyn_modular.h"
+#include "hybrid_rational.h"
+#include "modular.h"
+#include "modular_pair_filter.h"
+#include "monomial.h"
+#include "monomial_order.h"
+#include "polynomial.h"
+#include "polynomial_set.h"
+#include "small_modular.h"
+#include "serialization.h"
+#include "statistics.h"
+
+namespace grobner {
+
+// Canonical form of a generating set: zero generators are dropped, the others are divided by
+// their leading coefficients, terms are sorted by Order and generators by their text, duplicates
+// are merged. Permuted or scaled generators of the same ideal give the same text. The text is
+// in the format of Serializer<PolynomialSet>, preceded by a line with the order and the field.
+class IdealFingerprint {
+  public:
+    template<class Order, class ValueType>
+    static std::string get_canonical_text(const PolynomialSet<ValueType>& F);
+    // 64-bit FNV-1a of the canonical text as 16 hex digits, stable between runs and builds
+    template<class Order, class ValueType>
+    static std::string get(const PolynomialSet<ValueType>& F);
+    static std::string get_hash(const std::string& text);
+};
+
+// LRU cache of reduced Grobner bases keyed by IdealFingerprint. With a directory every basis is
+// also stored in <directory>/<fingerprint>.gb and loaded from there on a memory miss, so the
+// cache survives between processes; the directory must exist. An entry matches only if its
+// canonical text is equal to the one of the input, so hash collisions can't return a wrong
+// basis. With verification a hit is accepted only if it passes is_verified (catches edited or
+// corrupted files). All methods are thread-safe; loading, verification and the computation on a
+// miss run without the lock.
+template<class ValueType>
+class ResultCache {
+  public:
+    explicit ResultCache(size_t capacity, std::string directory = "", bool is_verifying = false);
+
+    // replaces F by its reduced Grobner basis, on a miss computes it by Algorithm and stores it
+    template<class Order>
+    void extend_to_grobners_basis(PolynomialSet<ValueType>* F);
+    template<class Order, class Monitor>
+    void extend_to_grobners_basis(PolynomialSet<ValueType>* F, Monitor* monitor);
+
+    template<class Order>
+    bool find(const PolynomialSet<ValueType>& F, PolynomialSet<ValueType>* basis);
+    // basis must be the reduced Grobner basis of F
+    template<class Order>
+    void insert(const PolynomialSet<ValueType>& F, const PolynomialSet<ValueType>& basis);
+
+    // true if basis is a reduced Grobner basis of an ideal containing F; for rational
+    // coefficients also its leading monomials must be the ones of the basis of the image of F
+    // modulo a prime, which rejects a basis of a larger ideal, e.g. {1}. Over finite fields the
+    // image is F itself, so this part is skipped and a basis of a larger ideal passes.
+    template<class Order>
+    static bool is_verified(const PolynomialSet<ValueType>& F, const PolynomialSet<ValueType>& basis);
+
+    size_t get_size() const;
+    size_t get_memory_hit_count() const;
+    size_t get_disk_hit_count() const;
+    size_t get_miss_count() const;
+    // hits rejected by verification, counted as misses too
+    size_t get_rejected_count() const;
+
+  private:
+    struct Entry {
+        std::string fingerprint;
+        std::string canonical_text;
+        PolynomialSet<ValueType> basis;
+    };
+
+    std::string get_path(const std::string& fingerprint) const;
+    // false if the file is missing, malformed or belongs to another input
+    bool load(const std::string& fingerprint, const std::string& canonical_text,
+              PolynomialSet<ValueType>* basis) const;
+    void save(const Entry& entry) const;
+    // requires the lock
+    void insert_to_memory(Entry entry);
+    // requires the lock, does nothing if the entry was replaced meanwhile
+    void erase_from_memory(const std::string& fingerprint, const PolynomialSet<ValueType>& basis);
+
+    template<class Order>
+    static bool is_reduced(const PolynomialSet<ValueType>& basis);
+    template<class Order>
+    static bool has_leading_monomials_of_image(const PolynomialSet<ValueType>& F, const PolynomialSet<ValueType>& basis);
+
+    size_t capacity_;
+    std::string directory_;
+    bool is_verifying_;
+
+    mutable std::mutex mutex_;
+    // most recently used first
+    std::list<Entry> entries_;
+    std::unordered_map<std::string, typename std::list<Entry>::iterator> positions_;
+
+    size_t memory_hit_count_ = 0;
+    size_t disk_hit_count_ = 0;
+    size_t miss_count_ = 0;
+    size_t rejected_count_ = 0;
+};
+
+
+template<class Order, class ValueType>
+std::string IdealFingerprint::get_canonical_text(const PolynomialSet<ValueType>& F) {
+    std::vector<std::string> generators;
+    for (const auto& f : F) {
+        if (f.is_zero()) {
+            continue;
+        }
+        auto monic = f / Algorithm::get_leading_term<Order>(f).second;
+        std::vector<std::pair<const Monomial*, const ValueType*>> terms;
+        terms.reserve(monic.size());
+        for (const auto& [monomial, coefficient] : monic) {
+            terms.emplace_back(&monomial, &coefficient);
+        }
+        std::sort(terms.begin(), terms.end(), [](const auto& a, const auto& b) { return Order()(*b.first, *a.first); });
+        std::ostringstream out;
+        out << terms.size();
+        for (const auto& [monomial, coefficient] : terms) {
+            out << ' ';
+            Serializer<ValueType>::write(out, *coefficient);
+            out << ' ';
+            Serializer<Monomial>::write(out, *monomial);
+        }
+        generators.push_back(out.str());
+    }
+    std::sort(generators.begin(), generators.end());
+    generators.erase(std::unique(generators.begin(), generators.end()), generators.end());
+
+    std::ostringstream out;
+    out << OrderName<Order>::get() << ' ' << FieldName<ValueType>::get() << '\n' << generators.size() << '\n';
+    for (const auto& generator : generators) {
+        out << generator << '\n';
+    }
+    return out.str();
+}
+
+template<class Order, class ValueType>
+std::string IdealFingerprint::get(const PolynomialSet<ValueType>& F) {
+    return get_hash(get_canonical_text<Order>(F));
+}
+
+inline std::string IdealFingerprint::get_hash(const std::string& text) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long)hash);
+    return buffer;
+}
+
+
+template<class ValueType>
+ResultCache<ValueType>::ResultCache(size_t capacity, std::string directory, bool is_verifying) :
+    capacity_(capacity),
+    directory_(std::move(directory)),
+    is_verifying_(is_verifying) {
+}
+
+template<class ValueType>
+template<class Order>
+void ResultCache<ValueType>::extend_to_grobners_basis(PolynomialSet<ValueType>* F) {
+    NoStatistics statistics;
+    extend_to_grobners_basis<Order>(F, &statistics);
+}
+
+template<class ValueType>
+template<class Order, class Monitor>
+void ResultCache<ValueType>::extend_to_grobners_basis(PolynomialSet<ValueType>* F, Monitor* monitor) {
+    PolynomialSet<ValueType> basis;
+    if (find<Order>(*F, &basis)) {
+        *F = std::move(basis);
+        return;
+    }
+    auto input = *F;
+    Algorithm::extend_to_grobners_basis<Order>(F, monitor);
+    insert<Order>(input, *F);
+}
+
+template<class ValueType>
+template<class Order>
+bool ResultCache<ValueType>::find(const PolynomialSet<ValueType>& F, PolynomialSet<ValueType>* basis) {
+    auto canonical_text = IdealFingerprint::get_canonical_text<Order>(F);
+    auto fingerprint = IdealFingerprint::get_hash(canonical_text);
+
+    // the entry is copied under the lock, the file is read and the basis is verified without it
+    bool is_in_memory = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto position = positions_.find(fingerprint);
+        if (position != positions_.end() && position->second->canonical_text == canonical_text) {
+            entries_.splice(entries_.begin(), entries_, position->second);
+            *basis = entries_.front().basis;
+            is_in_memory = true;
+        }
+    }
+    bool is_found = is_in_memory || (!directory_.empty() && load(fingerprint, canonical_text, basis));
+    bool is_accepted = is_found && (!is_verifying_ || is_verified<Order>(F, *basis));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (is_accepted && is_in_memory) {
+        ++memory_hit_count_;
+        return true;
+    }
+    if (is_accepted) {
+        insert_to_memory({fingerprint, std::move(canonical_text), *basis});
+        ++disk_hit_count_;
+        return true;
+    }
+    if (is_found) {
+        ++rejected_count_;
+        if (is_in_memory) {
+            erase_from_memory(fingerprint, *basis);
+        }
+    }
+    ++miss_count_;
+    return false;
+}
+
+template<class ValueType>
+template<class Order>
+void ResultCache<ValueType>::insert(const PolynomialSet<ValueType>& F, const PolynomialSet<ValueType>& basis) {
+    auto canonical_text = IdealFingerprint::get_canonical_text<Order>(F);
+    Entry entry{IdealFingerprint::get_hash(canonical_text), std::move(canonical_text), basis};
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!directory_.empty()) {
+        save(entry);
+    }
+    insert_to_memory(std::move(entry));
+}
+
+template<class ValueType>
+template<class Order>
+bool ResultCache<ValueType>::is_verified(const PolynomialSet<ValueType>& F, const PolynomialSet<ValueType>& basis) {
+    // cheap checks first
+    if (!is_reduced<Order>(basis) || !has_leading_monomials_of_image<Order>(F, basis)) {
+        return false;
+    }
+    for (const auto& f : F) {
+        auto g = f;
+        Algorithm::reduce_by<Order>(basis, &g);
+        if (!g.is_zero()) {
+            return false;
+        }
+    }
+    std::vector<const Polynomial<ValueType>*> polynomials;
+    for (const auto& f : basis) {
+        polynomials.push_back(&f);
+    }
+    for (size_t i = 0; i < polynomials.size(); ++i) {
+        for (size_t j = i + 1; j < polynomials.size(); ++j) {
+            auto S = Algorithm::get_S<Order>(*polynomials[i], *polynomials[j]);
+            Algorithm::reduce_by<Order>(basis, &S);
+            if (!S.is_zero()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template<class ValueType>
+template<class Order>
+bool ResultCache<ValueType>::is_reduced(const PolynomialSet<ValueType>& basis) {
+    std::vector<Monomial> leads;
+    for (const auto& f : basis) {
+        if (f.is_zero()) {
+            return false;
+        }
+        auto [lead, coefficient] = Algorithm::get_leading_term<Order>(f);
+        if (coefficient != ValueType(1)) {
+            return false;
+        }
+        leads.push_back(std::move(lead));
+    }
+    // no term is divisible by the leading monomial of another element
+    size_t i = 0;
+    for (const auto& f : basis) {
+        for (size_t j = 0; j < leads.size(); ++j) {
+            for (const auto& [monomial, coefficient] : f) {
+                if (j != i && monomial.is_divisible_by(leads[j])) {
+                    return false;
+                }
+            }
+        }
+        ++i;
+    }
+    return true;
+}
+
+template<class ValueType>
+template<class Order>
+bool ResultCache<ValueType>::has_leading_monomials_of_image(const PolynomialSet<ValueType>& F,
+                                                            const PolynomialSet<ValueType>& basis) {
+    if constexpr (HasModularImage<ValueType>::value) {
+        using Image = ModularImage<2'147'483'647ll>;
+        PolynomialSet<Modular<2'147'483'647ll>> image;
+        for (const auto& f : F) {
+            Polynomial<Modular<2'147'483'647ll>> f_image;
+            // a bad prime for this input, rejecting is safe: the basis is computed again
+            if (!Image::get(f, &f_image)) {
+                return false;
+            }
+            if (!f_image.is_zero()) {
+                image.insert(std::move(f_image));
+            }
+        }
+        Algorithm::extend_to_grobners_basis<Order>(&image);
+
+        // leading monomials of a reduced basis are the minimal generators of the leading ideal
+        std::vector<Monomial> expected;
+        for (const auto& f : image) {
+            expected.push_back(Algorithm::get_leading_term<Order>(f).first);
+        }
+        std::vector<Monomial> leads;
+        for (const auto& f : basis) {
+            leads.push_back(Algorithm::get_leading_term<Order>(f).first);
+        }
+        std::sort(expected.begin(), expected.end(), Order());
+        std::sort(leads.begin(), leads.end(), Order());
+        return leads == expected;
+    } else {
+        return true;
+    }
+}
+
+template<class ValueType>
+size_t ResultCache<ValueType>::get_size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+template<class ValueType>
+size_t ResultCache<ValueType>::get_memory_hit_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return memory_hit_count_;
+}
+
+template<class ValueType>
+size_t ResultCache<ValueType>::get_disk_hit_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return disk_hit_count_;
+}
+
+template<class ValueType>
+size_t ResultCache<ValueType>::get_miss_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return miss_count_;
+}
+
+template<class ValueType>
+size_t ResultCache<ValueType>::get_rejected_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rejected_count_;
+}
+
+template<class ValueType>
+std::string ResultCache<ValueType>::get_path(const std::string& fingerprint) const {
+    return directory_ + "/" + fingerprint + ".gb";
+}
+
+template<class ValueType>
+bool ResultCache<ValueType>::load(const std::string& fingerprint, const std::string& canonical_text,
+                                  PolynomialSet<ValueType>* basis) const {
+    std::ifstream in(get_path(fingerprint));
+    if (!in) {
+        return false;
+    }
+    try {
+        expect_token(in, "grobner_cache");
+        expect_token(in, "1");
+        expect_token(in, "input");
+        auto length = read_checked<size_t>(in);
+        in.get();
+        std::string text(length, '\0');
+        if (!in.read(text.data(), length) || text != canonical_text) {
+            return false;
+        }
+        expect_token(in, "basis");
+        *basis = Serializer<PolynomialSet<ValueType>>::read(in);
+        expect_token(in, "end");
+    } catch (const std::exception&) {
+        // not only std::runtime_error: e.g. a zero denominator throws boost::bad_rational
+        return false;
+    }
+    return true;
+}
+
+template<class ValueType>
+void ResultCache<ValueType>::save(const Entry& entry) const {
+    // same as Checkpoint::save, readers never see a partially written file
+    auto path = get_path(entry.fingerprint);
+    auto temporary_path = path + ".tmp";
+    {
+        std::ofstream out(temporary_path);
+        out << "grobner_cache 1\n";
+        out << "input " << entry.canonical_text.size() << '\n' << entry.canonical_text;
+        out << "basis ";
+        Serializer<PolynomialSet<ValueType>>::write(out, entry.basis);
+        out << "end\n";
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("can't write cache entry " + temporary_path);
+        }
+    }
+    if (std::rename(temporary_path.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("can't rename cache entry to " + path);
+    }
+}
+
+template<class ValueType>
+void ResultCache<ValueType>::insert_to_memory(Entry entry) {
+    auto position = positions_.find(entry.fingerprint);
+    if (position != positions_.end()) {
+        entries_.erase(position->second);
+        positions_.erase(position);
+    }
+    if (capacity_ == 0) {
+        return;
+    }
+    if (entries_.size() == capacity_) {
+        positions_.erase(entries_.back().fingerprint);
+        entries_.pop_back();
+    }
+    entries_.push_front(std::move(entry));
+    positions_[entries_.front().fingerprint] = entries_.begin();
+}
+
+template<class ValueType>
+void ResultCache<ValueType>::erase_from_memory(const std::string& fingerprint, const PolynomialSet<ValueType>& basis) {
+    auto position = positions_.find(fingerprint);
+    if (position != positions_.end() && position->second->basis == basis) {
+        entries_.erase(position->second);
+        positions_.erase(position);
+    }
+}
+
+}  // grobner
+
+#endif  // GROBNER_RESULT_CACHE_H_
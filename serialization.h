@@ -0,0 +1,261 @@
+#ifndef GROBNER_SERIALIZATION_H_
+#define GROBNER_SERIALIZATION_H_
+
+#include <boost/rational.hpp>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "modular.h"
+#include "monomial.h"
+#include "monomial_order.h"
+#include "polynomial.h"
+#include "polynomial_set.h"
+#include "statistics.h"
+
+namespace grobner {
+
+// Whitespace separated text format, unlike operator << it is exact for every value type
+// and any number of variables. read throws std::runtime_error on malformed input.
+template<class T>
+struct Serializer {
+    static void write(std::ostream& out, const T& value);
+    static T read(std::istream& in);
+};
+
+template<auto P>
+struct Serializer<Modular<P>> {
+    static void write(std::ostream& out, const Modular<P>& value);
+    static Modular<P> read(std::istream& in);
+};
+
+template<class ValueType>
+struct Serializer<boost::rational<ValueType>> {
+    static void write(std::ostream& out, const boost::rational<ValueType>& value);
+    static boost::rational<ValueType> read(std::istream& in);
+};
+
+template<>
+struct Serializer<Monomial> {
+    static void write(std::ostream& out, const Monomial& monomial);
+    static Monomial read(std::istream& in);
+};
+
+template<class ValueType>
+struct Serializer<Polynomial<ValueType>> {
+    static void write(std::ostream& out, const Polynomial<ValueType>& polynomial);
+    static Polynomial<ValueType> read(std::istream& in);
+};
+
+template<class ValueType>
+struct Serializer<PolynomialSet<ValueType>> {
+    static void write(std::ostream& out, const PolynomialSet<ValueType>& set);
+    static PolynomialSet<ValueType> read(std::istream& in);
+};
+
+// only the public counters, phase timings in progress are not saved
+template<>
+struct Serializer<Statistics> {
+    static void write(std::ostream& out, const Statistics& statistics);
+    static Statistics read(std::istream& in);
+};
+
+// names written into fingerprints and checkpoints, so that data of different orders and fields
+// never match
+template<class Order>
+struct OrderName;
+
+template<>
+struct OrderName<DegOrder> {
+    static std::string get() { return "deg"; }
+};
+
+template<>
+struct OrderName<LexOrder> {
+    static std::string get() { return "lex"; }
+};
+
+template<>
+struct OrderName<RevLexOrder> {
+    static std::string get() { return "revlex"; }
+};
+
+template<class FirstOrder, class SecondOrder>
+struct OrderName<OrderSum<FirstOrder, SecondOrder>> {
+    static std::string get() { return OrderName<FirstOrder>::get() + "+" + OrderName<SecondOrder>::get(); }
+};
+
+// value types with the same name must have the same serialized form of equal values
+template<class ValueType>
+struct FieldName;
+
+template<class IntType>
+struct FieldName<boost::rational<IntType>> {
+    static std::string get() { return "rational"; }
+};
+
+template<auto P>
+struct FieldName<Modular<P>> {
+    static std::string get() { return "mod" + std::to_string(P); }
+};
+
+// reads a value and checks the stream
+template<class T>
+T read_checked(std::istream& in);
+// reads a word and checks that it is equal to expected
+inline void expect_token(std::istream& in, const std::string& expected);
+
+
+template<class T>
+void Serializer<T>::write(std::ostream& out, const T& value) {
+    out << value;
+}
+
+template<class T>
+T Serializer<T>::read(std::istream& in) {
+    return read_checked<T>(in);
+}
+
+template<auto P>
+void Serializer<Modular<P>>::write(std::ostream& out, const Modular<P>& value) {
+    out << value.get_value();
+}
+
+template<auto P>
+Modular<P> Serializer<Modular<P>>::read(std::istream& in) {
+    return Modular<P>(read_checked<typename Modular<P>::ValueType>(in));
+}
+
+template<class ValueType>
+void Serializer<boost::rational<ValueType>>::write(std::ostream& out, const boost::rational<ValueType>& value) {
+    out << value.numerator() << ' ' << value.denominator();
+}
+
+template<class ValueType>
+boost::rational<ValueType> Serializer<boost::rational<ValueType>>::read(std::istream& in) {
+    auto numerator = read_checked<ValueType>(in);
+    auto denominator = read_checked<ValueType>(in);
+    if (denominator == 0) {
+        throw std::runtime_error("zero denominator in serialized data");
+    }
+    return boost::rational<ValueType>(numerator, denominator);
+}
+
+inline void Serializer<Monomial>::write(std::ostream& out, const Monomial& monomial) {
+    out << monomial.container_size();
+    for (size_t i = 0; i < monomial.container_size(); ++i) {
+        out << ' ' << monomial.get_degree(i);
+    }
+}
+
+inline Monomial Serializer<Monomial>::read(std::istream& in) {
+    auto size = read_checked<size_t>(in);
+    Monomial monomial;
+    for (size_t i = 0; i < size; ++i) {
+        monomial.set_degree(i, read_checked<Monomial::DegreeType>(in));
+    }
+    return monomial;
+}
+
+template<class ValueType>
+void Serializer<Polynomial<ValueType>>::write(std::ostream& out, const Polynomial<ValueType>& polynomial) {
+    out << polynomial.size();
+    for (const auto& [monomial, coefficient] : polynomial) {
+        out << ' ';
+        Serializer<ValueType>::write(out, coefficient);
+        out << ' ';
+        Serializer<Monomial>::write(out, monomial);
+    }
+}
+
+template<class ValueType>
+Polynomial<ValueType> Serializer<Polynomial<ValueType>>::read(std::istream& in) {
+    auto size = read_checked<size_t>(in);
+    Polynomial<ValueType> polynomial;
+    for (size_t i = 0; i < size; ++i) {
+        auto coefficient = Serializer<ValueType>::read(in);
+        polynomial.add_monomial(Serializer<Monomial>::read(in), coefficient);
+    }
+    return polynomial;
+}
+
+template<class ValueType>
+void Serializer<PolynomialSet<ValueType>>::write(std::ostream& out, const PolynomialSet<ValueType>& set) {
+    out << set.size() << '\n';
+    for (const auto& polynomial : set) {
+        Serializer<Polynomial<ValueType>>::write(out, polynomial);
+        out << '\n';
+    }
+}
+
+template<class ValueType>
+PolynomialSet<ValueType> Serializer<PolynomialSet<ValueType>>::read(std::istream& in) {
+    auto size = read_checked<size_t>(in);
+    PolynomialSet<ValueType> set;
+    for (size_t i = 0; i < size; ++i) {
+        set.insert(Serializer<Polynomial<ValueType>>::read(in));
+    }
+    return set;
+}
+
+inline void Serializer<Statistics>::write(std::ostream& out, const Statistics& statistics) {
+    out << statistics.pairs_created << ' ' << statistics.s_polynomials_reduced << ' '
+        << statistics.zero_reductions << ' ' << statistics.reduction_steps << ' '
+        << statistics.max_polynomial_length << ' ' << statistics.max_coefficient_bits << '\n';
+    for (auto count : statistics.pairs_eliminated) {
+        out << count << ' ';
+    }
+    out << '\n';
+    for (auto seconds : statistics.phase_seconds) {
+        out << seconds << ' ';
+    }
+    out << '\n' << statistics.basis_size_history.size();
+    for (const auto& [reduced, size] : statistics.basis_size_history) {
+        out << ' ' << reduced << ' ' << size;
+    }
+    out << '\n';
+}
+
+inline Statistics Serializer<Statistics>::read(std::istream& in) {
+    Statistics statistics;
+    statistics.pairs_created = read_checked<size_t>(in);
+    statistics.s_polynomials_reduced = read_checked<size_t>(in);
+    statistics.zero_reductions = read_checked<size_t>(in);
+    statistics.reduction_steps = read_checked<size_t>(in);
+    statistics.max_polynomial_length = read_checked<size_t>(in);
+    statistics.max_coefficient_bits = read_checked<size_t>(in);
+    for (auto& count : statistics.pairs_eliminated) {
+        count = read_checked<size_t>(in);
+    }
+    for (auto& seconds : statistics.phase_seconds) {
+        seconds = read_checked<double>(in);
+    }
+    auto history_size = read_checked<size_t>(in);
+    for (size_t i = 0; i < history_size; ++i) {
+        auto reduced = read_checked<size_t>(in);
+        auto size = read_checked<size_t>(in);
+        statistics.basis_size_history.emplace_back(reduced, size);
+    }
+    return statistics;
+}
+
+
+template<class T>
+T read_checked(std::istream& in) {
+    T value;
+    if (!(in >> value)) {
+        throw std::runtime_error("unexpected end of serialized data");
+    }
+    return value;
+}
+
+void expect_token(std::istream& in, const std::string& expected) {
+    auto token = read_checked<std::string>(in);
+    if (token != expected) {
+        throw std::runtime_error("expected '" + expected + "', got '" + token + "'");
+    }
+}
+
+}  // grobner
+
+#endif  // GROBNER_SERIALIZATION_H_
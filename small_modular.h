@@ -0,0 +1,246 @@
+#ifndef GROBNER_SMALL_MODULAR_H_
+#define GROBNER_SMALL_MODULAR_H_
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "hashes.h"
+#include "serialization.h"
+#include "statistics.h"
+
+namespace grobner {
+
+// Z/PZ for a prime P < 2^16 with the same interface as Modular<P>. Values are stored in
+// uint16_t, multiplication, division and inversion are lookups in tables of discrete logarithms
+// and powers of a primitive root, which are built at the first use and shared by all values.
+template<auto P>
+class SmallModular {
+  public:
+    using ValueType = long long;
+
+    SmallModular(ValueType value = 0);
+
+    static ValueType make_normal(ValueType value);
+
+    SmallModular get_pow(ValueType power) const;
+    SmallModular get_inverse() const;
+    ValueType get_value() const;
+
+    template<auto Q>
+    friend std::ostream& operator << (std::ostream& out, const SmallModular<Q>& other);
+    template<auto Q>
+    friend std::istream& operator >> (std::istream& in, SmallModular<Q>& other);
+
+    SmallModular operator - () const;
+
+    friend SmallModular& operator += (SmallModular& first, const SmallModular& second) {
+        unsigned sum = (unsigned)first.value_ + second.value_;
+        first.value_ = sum >= (unsigned)P ? sum - P : sum;
+        return first;
+    }
+    friend SmallModular operator + (const SmallModular& first, const SmallModular& second) {
+        auto result = first;
+        return result += second;
+    }
+    friend SmallModular& operator -= (SmallModular& first, const SmallModular& second) {
+        first.value_ = first.value_ >= second.value_ ? first.value_ - second.value_ : first.value_ + P - second.value_;
+        return first;
+    }
+    friend SmallModular operator - (const SmallModular& first, const SmallModular& second) {
+        auto result = first;
+        return result -= second;
+    }
+    friend SmallModular& operator *= (SmallModular& first, const SmallModular& second) {
+        if (first.value_ != 0 && second.value_ != 0) {
+            const auto& tables = get_tables();
+            first.value_ = tables.exp[tables.log[first.value_] + tables.log[second.value_]];
+        } else {
+            first.value_ = 0;
+        }
+        return first;
+    }
+    friend SmallModular operator * (const SmallModular& first, const SmallModular& second) {
+        auto result = first;
+        return result *= second;
+    }
+    // division by zero gives zero, like the multiplication by the inverse in Modular
+    friend SmallModular& operator /= (SmallModular& first, const SmallModular& second) {
+        if (first.value_ != 0 && second.value_ != 0) {
+            const auto& tables = get_tables();
+            first.value_ = tables.exp[tables.log[first.value_] + (P - 1) - tables.log[second.value_]];
+        } else {
+            first.value_ = 0;
+        }
+        return first;
+    }
+    friend SmallModular operator / (const SmallModular& first, const SmallModular& second) {
+        auto result = first;
+        return result /= second;
+    }
+
+    friend bool operator == (const SmallModular& first, const SmallModular& second) {
+        return first.value_ == second.value_;
+    }
+    friend bool operator != (const SmallModular& first, const SmallModular& second) {
+        return !(first == second);
+    }
+
+  private:
+    static constexpr bool is_prime(long long value) {
+        if (value < 2) {
+            return false;
+        }
+        for (long long d = 2; d * d <= value; ++d) {
+            if (value % d == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+    static_assert(P > 0 && P < (1 << 16) && is_prime(P), "SmallModular: P must be a prime below 2^16");
+
+    // exp[i] = g^i for a primitive root g and i < 2(P - 1), so that a sum of two logarithms needs
+    // no reduction; log[x] for x != 0 is in [0, P - 1)
+    struct Tables {
+        std::vector<uint16_t> exp;
+        std::vector<uint16_t> log;
+
+        Tables();
+    };
+
+    static const Tables& get_tables();
+
+    uint16_t value_;
+};
+
+template<auto P>
+struct CoefficientSize<SmallModular<P>> {
+    static size_t get_bits(const SmallModular<P>& value) {
+        return CoefficientSize<typename SmallModular<P>::ValueType>::get_bits(value.get_value());
+    }
+};
+
+template<auto P>
+struct hash<grobner::SmallModular<P>> {
+    size_t operator()(const grobner::SmallModular<P>& modular) const;
+};
+
+template<auto P>
+struct Serializer<SmallModular<P>> {
+    static void write(std::ostream& out, const SmallModular<P>& value);
+    static SmallModular<P> read(std::istream& in);
+};
+
+// values are written as for Modular<P>
+template<auto P>
+struct FieldName<SmallModular<P>> {
+    static std::string get() { return "mod" + std::to_string(P); }
+};
+
+
+template<auto P>
+SmallModular<P>::SmallModular(ValueType value) : value_(make_normal(value)) {}
+
+template<auto P>
+typename SmallModular<P>::ValueType SmallModular<P>::make_normal(ValueType value) {
+    value %= P;
+    if (value < 0) {
+        value += P;
+    }
+    return value;
+}
+
+template<auto P>
+SmallModular<P> SmallModular<P>::operator - () const {
+    SmallModular result;
+    result.value_ = value_ == 0 ? 0 : P - value_;
+    return result;
+}
+
+template<auto P>
+SmallModular<P> SmallModular<P>::get_pow(ValueType power) const {
+    if (power == 0) {
+        return SmallModular(1);
+    } else if (value_ == 0) {
+        return SmallModular(0);
+    }
+    const auto& tables = get_tables();
+    // the multiplicative group is cyclic of order P - 1
+    auto log = (long long)tables.log[value_] * (power % (P - 1)) % (P - 1);
+    if (log < 0) {
+        log += P - 1;
+    }
+    SmallModular result;
+    result.value_ = tables.exp[log];
+    return result;
+}
+
+template<auto P>
+SmallModular<P> SmallModular<P>::get_inverse() const {
+    return SmallModular(1) / *this;
+}
+
+template<auto P>
+typename SmallModular<P>::ValueType SmallModular<P>::get_value() const {
+    return value_;
+}
+
+template<auto P>
+std::ostream& operator << (std::ostream& out, const SmallModular<P>& other) {
+    return out << other.value_;
+}
+
+template<auto P>
+std::istream& operator >> (std::istream& in, SmallModular<P>& other) {
+    typename SmallModular<P>::ValueType tmp;
+    in >> tmp;
+    other = tmp;
+    return in;
+}
+
+
+template<auto P>
+SmallModular<P>::Tables::Tables() : exp(2 * (P - 1)), log(P, 0) {
+    // the first g whose powers run through the whole multiplicative group
+    for (unsigned g = 1; ; ++g) {
+        unsigned power = 1;
+        size_t order = 0;
+        do {
+            exp[order++] = power;
+            power = power * g % P;
+        } while (power != 1 && order < (size_t)(P - 1));
+        if (power == 1 && order == (size_t)(P - 1)) {
+            break;
+        }
+    }
+    for (size_t i = 0; i < (size_t)(P - 1); ++i) {
+        exp[i + P - 1] = exp[i];
+        log[exp[i]] = i;
+    }
+}
+
+template<auto P>
+const typename SmallModular<P>::Tables& SmallModular<P>::get_tables() {
+    static const Tables tables;
+    return tables;
+}
+
+template<auto P>
+size_t hash<grobner::SmallModular<P>>::operator()(const grobner::SmallModular<P>& modular) const {
+    return hash<typename grobner::SmallModular<P>::ValueType>()(modular.get_value());
+}
+
+template<auto P>
+void Serializer<SmallModular<P>>::write(std::ostream& out, const SmallModular<P>& value) {
+    out << value.get_value();
+}
+
+template<auto P>
+SmallModular<P> Serializer<SmallModular<P>>::read(std::istream& in) {
+    return SmallModular<P>(read_checked<typename SmallModular<P>::ValueType>(in));
+}
+
+}  // grobner
+
+#endif  // GROBNER_SMALL_MODULAR_H_
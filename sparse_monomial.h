@@ -0,0 +1,260 @@
+#ifndef GROBNER_SPARSE_MONOMIAL_H_
+#define GROBNER_SPARSE_MONOMIAL_H_
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "hashes.h"
+#include "monomial.h"
+
+namespace grobner {
+
+// Monomial with the same interface as Monomial, but storing only the variables with nonzero
+// degrees as (variable, degree) pairs sorted by variable, and the total degree. Products,
+// quotients, divisibility and order comparisons are merges of these lists, so their cost
+// depends on the number of variables in the monomials, not on the largest variable index.
+// Polynomial<ValueType, SparseMonomial> uses it for systems with many variables.
+class SparseMonomial {
+  public:
+    using DegreeType = Monomial::DegreeType;
+    using Power = std::pair<uint32_t, DegreeType>;
+
+    SparseMonomial();
+    // degrees of all variables, as in Monomial
+    SparseMonomial(std::initializer_list<DegreeType> degrees);
+    // use a..z as variables, for example: c^3bd^-3c^-1
+    SparseMonomial(std::string s);
+    explicit SparseMonomial(const Monomial& monomial);
+
+    DegreeType get_degree() const;
+
+    bool is_divisible_by(const SparseMonomial& other) const;
+
+    void read(std::stringstream& ss);
+
+    void set_all_degrees_to_zero();
+    // largest variable index plus one
+    size_t container_size() const;
+    DegreeType get_degree(size_t i) const;
+    void set_degree(size_t i, DegreeType degree);
+
+    // sorted by variable, degrees are nonzero
+    const std::vector<Power>& get_powers() const;
+    Monomial to_monomial() const;
+
+    // max of the degrees of every variable
+    static SparseMonomial get_LCM(const SparseMonomial& first, const SparseMonomial& second);
+
+    friend SparseMonomial& operator *= (SparseMonomial& first, const SparseMonomial& second) {
+        first = get_merged(first, second, [](DegreeType a, DegreeType b) { return a + b; });
+        return first;
+    }
+    friend SparseMonomial operator * (const SparseMonomial& first, const SparseMonomial& second) {
+        return get_merged(first, second, [](DegreeType a, DegreeType b) { return a + b; });
+    }
+
+    friend SparseMonomial& operator /= (SparseMonomial& first, const SparseMonomial& second) {
+        first = get_merged(first, second, [](DegreeType a, DegreeType b) { return a - b; });
+        return first;
+    }
+    friend SparseMonomial operator / (const SparseMonomial& first, const SparseMonomial& second) {
+        return get_merged(first, second, [](DegreeType a, DegreeType b) { return a - b; });
+    }
+
+    friend bool operator == (const SparseMonomial& first, const SparseMonomial& second) {
+        return first.degree_ == second.degree_ && first.powers_ == second.powers_;
+    }
+    friend bool operator != (const SparseMonomial& first, const SparseMonomial& second) {
+        return !(first == second);
+    }
+
+    friend std::ostream& operator << (std::ostream& out, const SparseMonomial& monomial);
+
+  private:
+    // the degree of every variable is operation(first degree, second degree), zeros are dropped
+    template<class Operation>
+    static SparseMonomial get_merged(const SparseMonomial& first, const SparseMonomial& second, Operation operation);
+
+    std::vector<Power> powers_;
+    DegreeType degree_ = 0;
+};
+
+template<>
+struct hash<grobner::SparseMonomial> {
+    size_t operator()(const grobner::SparseMonomial& monomial) const;
+};
+
+
+inline SparseMonomial::SparseMonomial() {}
+
+inline SparseMonomial::SparseMonomial(std::initializer_list<DegreeType> degrees) {
+    size_t i = 0;
+    for (auto degree : degrees) {
+        if (degree != 0) {
+            powers_.emplace_back(i, degree);
+            degree_ += degree;
+        }
+        ++i;
+    }
+}
+
+inline SparseMonomial::SparseMonomial(std::string s) {
+    std::stringstream ss(s);
+    read(ss);
+}
+
+inline SparseMonomial::SparseMonomial(const Monomial& monomial) {
+    for (size_t i = 0; i < monomial.container_size(); ++i) {
+        if (monomial.get_degree(i) != 0) {
+            powers_.emplace_back(i, monomial.get_degree(i));
+            degree_ += monomial.get_degree(i);
+        }
+    }
+}
+
+inline SparseMonomial::DegreeType SparseMonomial::get_degree() const {
+    return degree_;
+}
+
+inline bool SparseMonomial::is_divisible_by(const SparseMonomial& other) const {
+    if (degree_ < other.degree_) {
+        return false;
+    }
+    size_t i = 0;
+    for (const auto& [variable, degree] : other.powers_) {
+        while (i < powers_.size() && powers_[i].first < variable) {
+            if (powers_[i].second < 0) {
+                return false;
+            }
+            ++i;
+        }
+        DegreeType own_degree = i < powers_.size() && powers_[i].first == variable ? powers_[i++].second : 0;
+        if (own_degree < degree) {
+            return false;
+        }
+    }
+    for (; i < powers_.size(); ++i) {
+        if (powers_[i].second < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline void SparseMonomial::read(std::stringstream& ss) {
+    Monomial monomial;
+    monomial.read(ss);
+    *this = SparseMonomial(monomial);
+}
+
+inline void SparseMonomial::set_all_degrees_to_zero() {
+    powers_.clear();
+    degree_ = 0;
+}
+
+inline size_t SparseMonomial::container_size() const {
+    return powers_.empty() ? 0 : powers_.back().first + 1;
+}
+
+inline SparseMonomial::DegreeType SparseMonomial::get_degree(size_t i) const {
+    auto it = std::lower_bound(powers_.begin(), powers_.end(), Power(i, 0), [](const Power& a, const Power& b) {
+        return a.first < b.first;
+    });
+    return it != powers_.end() && it->first == i ? it->second : 0;
+}
+
+inline void SparseMonomial::set_degree(size_t i, DegreeType degree) {
+    auto it = std::lower_bound(powers_.begin(), powers_.end(), Power(i, 0), [](const Power& a, const Power& b) {
+        return a.first < b.first;
+    });
+    if (it != powers_.end() && it->first == i) {
+        degree_ -= it->second;
+        if (degree == 0) {
+            powers_.erase(it);
+        } else {
+            it->second = degree;
+        }
+    } else if (degree != 0) {
+        powers_.insert(it, Power(i, degree));
+    }
+    degree_ += degree;
+}
+
+inline const std::vector<SparseMonomial::Power>& SparseMonomial::get_powers() const {
+    return powers_;
+}
+
+inline Monomial SparseMonomial::to_monomial() const {
+    Monomial monomial;
+    for (const auto& [variable, degree] : powers_) {
+        monomial.set_degree(variable, degree);
+    }
+    return monomial;
+}
+
+inline SparseMonomial SparseMonomial::get_LCM(const SparseMonomial& first, const SparseMonomial& second) {
+    return get_merged(first, second, [](DegreeType a, DegreeType b) { return std::max(a, b); });
+}
+
+template<class Operation>
+SparseMonomial SparseMonomial::get_merged(const SparseMonomial& first, const SparseMonomial& second,
+                                          Operation operation) {
+    SparseMonomial result;
+    result.powers_.reserve(first.powers_.size() + second.powers_.size());
+    auto add = [&result](uint32_t variable, DegreeType degree) {
+        if (degree != 0) {
+            result.powers_.emplace_back(variable, degree);
+            result.degree_ += degree;
+        }
+    };
+    size_t i = 0, j = 0;
+    while (i < first.powers_.size() || j < second.powers_.size()) {
+        if (j == second.powers_.size() || (i < first.powers_.size() && first.powers_[i].first < second.powers_[j].first)) {
+            add(first.powers_[i].first, operation(first.powers_[i].second, 0));
+            ++i;
+        } else if (i == first.powers_.size() || second.powers_[j].first < first.powers_[i].first) {
+            add(second.powers_[j].first, operation(0, second.powers_[j].second));
+            ++j;
+        } else {
+            add(first.powers_[i].first, operation(first.powers_[i].second, second.powers_[j].second));
+            ++i;
+            ++j;
+        }
+    }
+    return result;
+}
+
+inline std::ostream& operator << (std::ostream& out, const SparseMonomial& monomial) {
+    bool use_alphabet = (monomial.container_size() <= 26);  // same as for Monomial
+    for (const auto& [variable, degree] : monomial.powers_) {
+        if (use_alphabet) {
+            out << (char)('a' + variable);
+        } else {
+            out << 'x' << (variable + 1);
+        }
+        if (degree != 1) {
+            out << '^' << degree;
+        }
+    }
+    return out;
+}
+
+inline size_t hash<grobner::SparseMonomial>::operator()(const grobner::SparseMonomial& monomial) const {
+    size_t result = 0;
+    for (const auto& [variable, degree] : monomial.get_powers()) {
+        auto power = (uint64_t(variable) << 32) | uint32_t(degree);
+        result = result * 0x9e3779b97f4a7c15ull + std::hash<uint64_t>()(power);
+    }
+    return result;
+}
+
+}  // grobner
+
+#endif  // GROBNER_SPARSE_MONOMIAL_H_
@@ -7,6 +7,7 @@
 #include <iostream>
 
 #include "algorithm.h"
+#include "benchmark_systems.h"
 #include "modular.h"
 #include "monomial.h"
 #include "polynomial.h"
@@ -23,10 +24,6 @@ class SpeedTests {
     inline static void test_cyclic(int variable_count);
 
   private:
-    template<class ValueType>
-    inline static PolynomialSet<ValueType> get_cyclic(int variable_count);
-    template<class ValueType>
-    inline static Polynomial<ValueType> get_sigma(int variable_count, int sigma_index);
     template<class ValueType>
     inline static void run_buchberger_with_degrevlex(PolynomialSet<ValueType>* F);
 };
@@ -56,14 +53,14 @@ void SpeedTests::test_cyclic(int variable_count) {
 
     std::cout << "Testing cyclic(" << variable_count << ")..." << std::endl;
 
-    auto cyclic1 = get_cyclic<ValueType>(variable_count);
+    auto cyclic1 = BenchmarkSystems::get_cyclic<ValueType>(variable_count);
     test_time(Algorithm::extend_to_grobners_basis<Lex, ValueType>, "Without DegRevLex: ")(&cyclic1);
     for (auto f : cyclic1) {
         std::cout << f << std::endl;
     }
     std::cout << std::endl;
 
-    // auto cyclic2 = get_cyclic<ValueType>(variable_count);
+    // auto cyclic2 = BenchmarkSystems::get_cyclic<ValueType>(variable_count);
     // test_time(run_buchberger_with_degrevlex<ValueType>, "With DegRevLex: ")(&cyclic2);
     // for (auto f : cyclic2) {
     //     std::cout << f << std::endl;
@@ -73,38 +70,6 @@ void SpeedTests::test_cyclic(int variable_count) {
     // assert(cyclic1 == cyclic2);
 }
 
-template<class ValueType>
-PolynomialSet<ValueType> SpeedTests::get_cyclic(int variable_count) {
-    PolynomialSet<ValueType> result;
-    for (int i = 1; i < variable_count; ++i) {
-        result.insert(get_sigma<ValueType>(variable_count, i));
-    }
-    if (variable_count % 2 == 0) {
-        result.insert(get_sigma<ValueType>(variable_count, variable_count) + ValueType(1));
-    } else {
-        result.insert(get_sigma<ValueType>(variable_count, variable_count) - ValueType(1));
-    }
-    return std::move(result);
-}
-
-template<class ValueType>
-Polynomial<ValueType> SpeedTests::get_sigma(int variable_count, int sigma_index) {
-    if (sigma_index == 0) {
-        return Polynomial<ValueType>(1);
-    }
-    if (variable_count == sigma_index) {
-        Monomial sigma;
-        for (int i = 0; i < variable_count; ++i) {
-            sigma.set_degree(i, 1);
-        }
-        return Polynomial<ValueType>(sigma);
-    }
-    Monomial x_n;
-    x_n.set_degree(variable_count - 1, 1);
-    return std::move(get_sigma<ValueType>(variable_count - 1, sigma_index) +
-                     get_sigma<ValueType>(variable_count - 1, sigma_index - 1) * x_n);
-}
-
 template<class ValueType>
 void SpeedTests::run_buchberger_with_degrevlex(PolynomialSet<ValueType>* F) {
     using Lex = LexOrder;
@@ -0,0 +1,325 @@
+#ifndef GROBNER_STATISTICS_H_
+#define GROBNER_STATISTICS_H_
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/rational.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "declarations.h"
+
+namespace grobner {
+
+// Algorithm takes a monitor as a template parameter and calls it at interesting points.
+// NoStatistics does nothing and is optimized away completely, Statistics collects counters.
+// Other monitors can inherit NoStatistics and override only the hooks they need.
+
+enum class Phase {
+    kGetS,
+    kReduce,
+    kAutoReduce,
+    kPhaseCount
+};
+
+enum class PairCriterion {
+    // S-polynomial is zero right after construction
+    kZeroS,
+    // the same S-polynomial is already waiting to be reduced
+    kDuplicate,
+    // dropped by a pair filter, e.g. its image modulo a prime reduces to zero
+    kFiltered,
+    kCriterionCount
+};
+
+template<class ValueType>
+struct CoefficientSize {
+    static size_t get_bits(const ValueType& value);
+};
+
+class NoStatistics {
+  public:
+    void on_pair_created() {}
+    void on_pair_eliminated(PairCriterion) {}
+    // S-polynomial is taken from the queue
+    template<class ValueType, class MonomialType>
+    void on_pair_selected(const Polynomial<ValueType, MonomialType>&) {}
+    template<class ValueType, class MonomialType>
+    void on_reduction_started(const Polynomial<ValueType, MonomialType>&) {}
+    template<class ValueType, class MonomialType>
+    void on_reduction_finished(const Polynomial<ValueType, MonomialType>&) {}
+    void on_reduction_step() {}
+    template<class ValueType, class MonomialType>
+    void on_basis_inserted(const Polynomial<ValueType, MonomialType>&) {}
+    template<class ValueType, class MonomialType>
+    void on_basis_changed(const PolynomialSet<ValueType, MonomialType>&) {}
+    // end of an iteration of the main loop, the state (F, set_of_s) is consistent here
+    template<class ValueType, class MonomialType>
+    void on_iteration_finished(const PolynomialSet<ValueType, MonomialType>&, const PolynomialSet<ValueType, MonomialType>&) {}
+    void on_phase_started(Phase) {}
+    void on_phase_finished(Phase) {}
+};
+
+class Statistics : public NoStatistics {
+  public:
+    size_t pairs_created = 0;
+    size_t pairs_eliminated[size_t(PairCriterion::kCriterionCount)] = {};
+    size_t s_polynomials_reduced = 0;
+    size_t zero_reductions = 0;
+    size_t reduction_steps = 0;
+    size_t max_polynomial_length = 0;
+    size_t max_coefficient_bits = 0;
+    // (s_polynomials_reduced, basis size) after every change of the basis
+    std::vector<std::pair<size_t, size_t>> basis_size_history;
+    // inclusive, time of reductions made by auto_reduce is counted in both phases
+    double phase_seconds[size_t(Phase::kPhaseCount)] = {};
+
+    void on_pair_created();
+    void on_pair_eliminated(PairCriterion criterion);
+    template<class ValueType, class MonomialType>
+    void on_reduction_started(const Polynomial<ValueType, MonomialType>& f);
+    template<class ValueType, class MonomialType>
+    void on_reduction_finished(const Polynomial<ValueType, MonomialType>& f);
+    void on_reduction_step();
+    template<class ValueType, class MonomialType>
+    void on_basis_changed(const PolynomialSet<ValueType, MonomialType>& F);
+    void on_phase_started(Phase phase);
+    void on_phase_finished(Phase phase);
+
+    static std::string get_name(Phase phase);
+    static std::string get_name(PairCriterion criterion);
+
+    // flat list of all scalar counters, used for reports
+    std::vector<std::pair<std::string, double>> get_counters() const;
+
+    friend std::ostream& operator << (std::ostream& out, const Statistics& statistics);
+
+  private:
+    template<class ValueType, class MonomialType>
+    void update_maximums(const Polynomial<ValueType, MonomialType>& f);
+
+    // phases can be nested into themselves, only the outermost one is timed
+    size_t phase_depth_[size_t(Phase::kPhaseCount)] = {};
+    std::chrono::steady_clock::time_point phase_start_[size_t(Phase::kPhaseCount)];
+};
+
+
+// forwards every hook to both monitors
+template<class FirstMonitor, class SecondMonitor>
+class CombinedMonitor {
+  public:
+    CombinedMonitor(FirstMonitor* first, SecondMonitor* second);
+
+    void on_pair_created() {
+        first_->on_pair_created();
+        second_->on_pair_created();
+    }
+    void on_pair_eliminated(PairCriterion criterion) {
+        first_->on_pair_eliminated(criterion);
+        second_->on_pair_eliminated(criterion);
+    }
+    template<class ValueType, class MonomialType>
+    void on_pair_selected(const Polynomial<ValueType, MonomialType>& f) {
+        first_->on_pair_selected(f);
+        second_->on_pair_selected(f);
+    }
+    template<class ValueType, class MonomialType>
+    void on_reduction_started(const Polynomial<ValueType, MonomialType>& f) {
+        first_->on_reduction_started(f);
+        second_->on_reduction_started(f);
+    }
+    template<class ValueType, class MonomialType>
+    void on_reduction_finished(const Polynomial<ValueType, MonomialType>& f) {
+        first_->on_reduction_finished(f);
+        second_->on_reduction_finished(f);
+    }
+    void on_reduction_step() {
+        first_->on_reduction_step();
+        second_->on_reduction_step();
+    }
+    template<class ValueType, class MonomialType>
+    void on_basis_inserted(const Polynomial<ValueType, MonomialType>& f) {
+        first_->on_basis_inserted(f);
+        second_->on_basis_inserted(f);
+    }
+    template<class ValueType, class MonomialType>
+    void on_basis_changed(const PolynomialSet<ValueType, MonomialType>& F) {
+        first_->on_basis_changed(F);
+        second_->on_basis_changed(F);
+    }
+    template<class ValueType, class MonomialType>
+    void on_iteration_finished(const PolynomialSet<ValueType, MonomialType>& F, const PolynomialSet<ValueType, MonomialType>& set_of_s) {
+        first_->on_iteration_finished(F, set_of_s);
+        second_->on_iteration_finished(F, set_of_s);
+    }
+    void on_phase_started(Phase phase) {
+        first_->on_phase_started(phase);
+        second_->on_phase_started(phase);
+    }
+    void on_phase_finished(Phase phase) {
+        first_->on_phase_finished(phase);
+        second_->on_phase_finished(phase);
+    }
+
+  private:
+    FirstMonitor* first_;
+    SecondMonitor* second_;
+};
+
+
+template<class FirstMonitor, class SecondMonitor>
+CombinedMonitor<FirstMonitor, SecondMonitor>::CombinedMonitor(FirstMonitor* first, SecondMonitor* second) :
+    first_(first),
+    second_(second) {
+}
+
+template<class ValueType>
+size_t CoefficientSize<ValueType>::get_bits(const ValueType& value) {
+    if constexpr (std::is_integral_v<ValueType>) {
+        using Unsigned = std::make_unsigned_t<ValueType>;
+        Unsigned absolute = value < 0 ? Unsigned(0) - Unsigned(value) : Unsigned(value);
+        size_t bits = 0;
+        while (absolute != 0) {
+            absolute >>= 1;
+            ++bits;
+        }
+        return bits;
+    } else {
+        return 0;
+    }
+}
+
+template<>
+struct CoefficientSize<boost::multiprecision::cpp_int> {
+    static size_t get_bits(const boost::multiprecision::cpp_int& value) {
+        return value == 0 ? 0 : boost::multiprecision::msb(abs(value)) + 1;
+    }
+};
+
+template<class ValueType>
+struct CoefficientSize<boost::rational<ValueType>> {
+    static size_t get_bits(const boost::rational<ValueType>& value) {
+        return CoefficientSize<ValueType>::get_bits(value.numerator()) +
+               CoefficientSize<ValueType>::get_bits(value.denominator());
+    }
+};
+
+
+inline void Statistics::on_pair_created() {
+    ++pairs_created;
+}
+
+inline void Statistics::on_pair_eliminated(PairCriterion criterion) {
+    ++pairs_eliminated[size_t(criterion)];
+}
+
+template<class ValueType, class MonomialType>
+void Statistics::on_reduction_started(const Polynomial<ValueType, MonomialType>& f) {
+    update_maximums(f);
+}
+
+template<class ValueType, class MonomialType>
+void Statistics::on_reduction_finished(const Polynomial<ValueType, MonomialType>& f) {
+    ++s_polynomials_reduced;
+    if (f.is_zero()) {
+        ++zero_reductions;
+    }
+    update_maximums(f);
+}
+
+inline void Statistics::on_reduction_step() {
+    ++reduction_steps;
+}
+
+template<class ValueType, class MonomialType>
+void Statistics::on_basis_changed(const PolynomialSet<ValueType, MonomialType>& F) {
+    basis_size_history.emplace_back(s_polynomials_reduced, F.size());
+    for (const auto& f : F) {
+        update_maximums(f);
+    }
+}
+
+inline void Statistics::on_phase_started(Phase phase) {
+    if (phase_depth_[size_t(phase)]++ == 0) {
+        phase_start_[size_t(phase)] = std::chrono::steady_clock::now();
+    }
+}
+
+inline void Statistics::on_phase_finished(Phase phase) {
+    if (--phase_depth_[size_t(phase)] == 0) {
+        phase_seconds[size_t(phase)] +=
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - phase_start_[size_t(phase)]).count();
+    }
+}
+
+inline std::string Statistics::get_name(Phase phase) {
+    switch (phase) {
+        case Phase::kGetS:
+            return "get_S";
+        case Phase::kReduce:
+            return "reduce_by";
+        case Phase::kAutoReduce:
+            return "auto_reduce";
+        default:
+            return "unknown";
+    }
+}
+
+inline std::string Statistics::get_name(PairCriterion criterion) {
+    switch (criterion) {
+        case PairCriterion::kZeroS:
+            return "zero_s";
+        case PairCriterion::kDuplicate:
+            return "duplicate";
+        case PairCriterion::kFiltered:
+            return "filtered";
+        default:
+            return "unknown";
+    }
+}
+
+inline std::vector<std::pair<std::string, double>> Statistics::get_counters() const {
+    std::vector<std::pair<std::string, double>> counters = {
+        {"pairs_created", pairs_created},
+        {"s_polynomials_reduced", s_polynomials_reduced},
+        {"zero_reductions", zero_reductions},
+        {"reduction_steps", reduction_steps},
+        {"max_polynomial_length", max_polynomial_length},
+        {"max_coefficient_bits", max_coefficient_bits},
+        {"basis_changes", basis_size_history.size()},
+    };
+    for (size_t i = 0; i < size_t(PairCriterion::kCriterionCount); ++i) {
+        counters.emplace_back("pairs_eliminated_" + get_name(PairCriterion(i)), pairs_eliminated[i]);
+    }
+    for (size_t i = 0; i < size_t(Phase::kPhaseCount); ++i) {
+        counters.emplace_back("seconds_" + get_name(Phase(i)), phase_seconds[i]);
+    }
+    return counters;
+}
+
+inline std::ostream& operator << (std::ostream& out, const Statistics& statistics) {
+    for (const auto& [name, value] : statistics.get_counters()) {
+        out << name << ": " << value << '\n';
+    }
+    out << "basis_size_history:";
+    for (const auto& [reduced, size] : statistics.basis_size_history) {
+        out << ' ' << reduced << ':' << size;
+    }
+    return out << '\n';
+}
+
+template<class ValueType, class MonomialType>
+void Statistics::update_maximums(const Polynomial<ValueType, MonomialType>& f) {
+    max_polynomial_length = std::max(max_polynomial_length, f.size());
+    for (const auto& [monomial, coefficient] : f) {
+        max_coefficient_bits = std::max(max_coefficient_bits, CoefficientSize<ValueType>::get_bits(coefficient));
+    }
+}
+
+}  // grobner
+
+#endif  // GROBNER_STATISTICS_H_
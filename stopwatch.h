@@ -0,0 +1,76 @@
+#ifndef GROBNER_STOPWATCH_H_
+#define GROBNER_STOPWATCH_H_
+
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <string>
+
+#include <sys/resource.h>
+
+namespace grobner {
+
+// measures wall and cpu time since construction or the last restart
+class Stopwatch {
+  public:
+    Stopwatch();
+
+    void restart();
+
+    double get_wall_seconds() const;
+    double get_cpu_seconds() const;
+
+    // peak resident set size of the process since its start or the last successful
+    // reset_peak_rss
+    static long get_peak_rss_kb();
+    // makes the current resident set size the peak (Linux 4.0+, through /proc/self/clear_refs),
+    // returns false if it is not supported, then the peak stays process-wide
+    static bool reset_peak_rss();
+
+  private:
+    std::chrono::steady_clock::time_point wall_start_;
+    std::clock_t cpu_start_;
+};
+
+
+inline Stopwatch::Stopwatch() {
+    restart();
+}
+
+inline void Stopwatch::restart() {
+    wall_start_ = std::chrono::steady_clock::now();
+    cpu_start_ = std::clock();
+}
+
+inline double Stopwatch::get_wall_seconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start_).count();
+}
+
+inline double Stopwatch::get_cpu_seconds() const {
+    return double(std::clock() - cpu_start_) / CLOCKS_PER_SEC;
+}
+
+inline long Stopwatch::get_peak_rss_kb() {
+    // VmHWM is reset by reset_peak_rss, ru_maxrss is not
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return std::stol(line.substr(6));
+        }
+    }
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+inline bool Stopwatch::reset_peak_rss() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+    clear_refs.close();
+    return clear_refs.good();
+}
+
+}  // grobner
+
+#endif  // GROBNER_STOPWATCH_H_
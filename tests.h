@@ -1,18 +1,45 @@
 #ifndef GROBNER_TESTS_H_
 #define GROBNER_TESTS_H_
 
+#include <boost/multiprecision/cpp_int.hpp>
 #include <boost/rational.hpp>
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 
 #include "algorithm.h"
+#include "allocation_counter.h"
+#include "benchmark_systems.h"
+#include "boolean_algorithm.h"
+#include "boolean_polynomial.h"
+#include "checkpoint.h"
+#include "dyn_modular.h"
+#include "fraction_free.h"
+#include "homogenization.h"
+#include "hybrid_rational.h"
+#include "job_pool.h"
+#include "linear_elimination.h"
 #include "modular.h"
+#include "modular_pair_filter.h"
+#include "multi_prime.h"
 #include "monomial.h"
 #include "monomial_order.h"
 #include "polynomial.h"
+#include "polynomial_basis.h"
 #include "polynomial_order.h"
 #include "polynomial_set.h"
+#include "quotient_ring.h"
+#include "result_cache.h"
+#include "serialization.h"
+#include "small_modular.h"
+#include "sparse_monomial.h"
+#include "statistics.h"
+#include "trace_replay.h"
+#include "tracer.h"
+#include "variable_order.h"
 
 namespace grobner {
 
@@ -24,13 +51,47 @@ class Tests {
     inline static void test_monomial();
     inline static void test_polynomial();
     inline static void test_polynomial_set();
+    inline static void test_polynomial_basis();
     inline static void test_monomial_order();
     inline static void test_polynomial_order();
     inline static void test_algorithm();
+    inline static void test_statistics();
+    inline static void test_tracer();
+    inline static void test_serialization();
+    inline static void test_checkpoint();
+    inline static void test_fraction_free();
+    inline static void test_hybrid_rational();
+    inline static void test_allocations();
+    inline static void test_modular_pair_filter();
+    inline static void test_dyn_modular();
+    inline static void test_trace_replay();
+    inline static void test_multi_prime();
+    inline static void test_job_pool();
+    inline static void test_result_cache();
+    inline static void test_boolean_ring();
+    inline static void test_small_modular();
+    inline static void test_sparse_monomial();
+    inline static void test_linear_elimination();
+    inline static void test_variable_order();
+    inline static void test_degree_truncation();
+    inline static void test_homogenization();
+    inline static void test_top_reduction();
+    inline static void test_quotient_ring();
  
   private:
+    using TestSystem = PolynomialSet<Modular<1'000'000'007ll>>;
+
     inline static void test_rational_polynomial();
     inline static void test_z_p_polynomial();
+
+    // small systems for comparing a variant of the algorithm with Algorithm: a mixed one, a
+    // system linear in b, katsura(3) and cyclic(4) in DegRevLex; the Lex ones are smaller, since
+    // the naive algorithm is much slower in Lex
+    inline static std::vector<TestSystem> get_degrevlex_systems();
+    inline static std::vector<TestSystem> get_lex_systems();
+    // function(&F) must give the same reduced basis as Algorithm::extend_to_grobners_basis<Order>
+    template<class Order, class Function>
+    static void check_same_basis(const std::vector<TestSystem>& systems, Function function);
 };
 
 void Tests::test_all() {
@@ -38,9 +99,32 @@ void Tests::test_all() {
     test_monomial();
     test_polynomial();
     test_polynomial_set();
+    test_polynomial_basis();
     test_monomial_order();
     test_polynomial_order();
     test_algorithm();
+    test_statistics();
+    test_tracer();
+    test_serialization();
+    test_checkpoint();
+    test_fraction_free();
+    test_hybrid_rational();
+    test_allocations();
+    test_modular_pair_filter();
+    test_dyn_modular();
+    test_trace_replay();
+    test_multi_prime();
+    test_job_pool();
+    test_result_cache();
+    test_boolean_ring();
+    test_small_modular();
+    test_sparse_monomial();
+    test_linear_elimination();
+    test_variable_order();
+    test_degree_truncation();
+    test_homogenization();
+    test_top_reduction();
+    test_quotient_ring();
 }
 
 void Tests::test_modular() {
@@ -178,6 +262,49 @@ void Tests::test_polynomial_set() {
     std::cout << "PolynomialSet tests passed" << std::endl;
 }
 
+void Tests::test_polynomial_basis() {
+    using Value = Modular<17ll>;
+    using Poly = Polynomial<Value>;
+    using Set = PolynomialSet<Value>;
+    using Basis = PolynomialBasis<Value>;
+
+    Basis basis;
+    assert(basis.empty());
+    auto a = basis.insert(Poly("1a"));
+    auto b = basis.insert(Poly("2c+3d"));
+    auto c = basis.insert(Poly("1a"));
+    assert(a == 0 && b == 1 && c == 2);
+    assert(basis.size() == 3);
+    assert(basis[b] == Poly("2c+3d"));
+
+    basis.erase(a);
+    assert(!basis.contains(a) && basis.contains(b));
+    assert(basis.size() == 2);
+    assert(basis.get_ids() == std::vector<Basis::Id>({b, c}));
+    auto d = basis.insert(Poly("1b"));
+    assert(d == 3);
+    assert(basis.extract(b) == Poly("2c+3d"));
+    int count = 0;
+    for (const auto& f : basis) {
+        assert(f == Poly("1a") || f == Poly("1b"));
+        ++count;
+    }
+    assert(count == 2);
+    assert(std::move(basis).to_set() == Set({Poly("1a"), Poly("1b")}));
+
+    Basis unique(Set{Poly("1a"), Poly("2c+3d")}, true);
+    assert(unique.size() == 2);
+    auto e = unique.find(Poly("3d+2c"));
+    assert(e != Basis::kNoId && unique[e] == Poly("2c+3d"));
+    assert(unique.insert(Poly("2c+3d")) == e);
+    assert(unique.size() == 2);
+    unique.erase(e);
+    assert(unique.find(Poly("2c+3d")) == Basis::kNoId);
+    assert(unique.insert(Poly("2c+3d")) != e);
+
+    std::cout << "PolynomialBasis tests passed" << std::endl;
+}
+
 void Tests::test_monomial_order() {
     using Deg = DegOrder;
     using Lex = LexOrder;
@@ -279,9 +406,1459 @@ void Tests::test_algorithm() {
         assert(S == Poly());
     }
 
+    // elements whose leading monomials become divisible by a new one get new leading monomials,
+    // and their pairs are needed too
+    using DegRevLex = OrderSum<Deg, RevLexOrder>;
+    using BigPoly = Polynomial<Modular<1'000'000'007ll>>;
+    PolynomialSet<Modular<1'000'000'007ll>> G{BigPoly("1a^3c+1b"), BigPoly("1c+1a^2c^5-1a^2c^2+1c^2"),
+                                              BigPoly("1c^3+1a^4c^2+1a^4-1"), BigPoly("1a^6+1a^2c^3-1a^2+1c^2+1a^4c")};
+    Algorithm::extend_to_grobners_basis<DegRevLex>(&G);
+    assert(G.find(BigPoly("1a^3b^2-1b^3c+1bc+1b")) != G.end());
+    for (auto it = G.pbegin(); it != G.pend(); ++it) {
+        auto [f1, f2] = *it;
+        auto S = Algorithm::get_S<DegRevLex>(f1, f2);
+        Algorithm::reduce_by<DegRevLex>(G, &S);
+        assert(S == BigPoly());
+    }
+
     std::cout << "Algorithm tests passed" << std::endl;
 }
 
+void Tests::test_statistics() {
+    using DegLex = OrderSum<DegOrder, LexOrder>;
+
+    using Value = Modular<17ll>;
+    using Poly = Polynomial<Value>;
+    using Set = PolynomialSet<Value>;
+
+    assert(CoefficientSize<long long>::get_bits(0) == 0);
+    assert(CoefficientSize<long long>::get_bits(-8) == 4);
+    assert(CoefficientSize<boost::rational<long long>>::get_bits(boost::rational<long long>(3, 4)) == 5);
+    assert(CoefficientSize<Value>::get_bits(Value(16)) == 5);
+
+    Set F = {Poly("1ab-1d"), Poly("1ac-1d"), Poly("1a^2+1b^2+1c^2")};
+    Set G = F;
+    Statistics statistics;
+    Algorithm::extend_to_grobners_basis<DegLex>(&F, &statistics);
+    Algorithm::extend_to_grobners_basis<DegLex>(&G);
+    assert(F == G);
+
+    size_t eliminated = 0;
+    for (auto count : statistics.pairs_eliminated) {
+        eliminated += count;
+    }
+    assert(statistics.pairs_created > 0);
+    assert(statistics.s_polynomials_reduced > 0);
+    assert(statistics.zero_reductions <= statistics.s_polynomials_reduced);
+    assert(statistics.s_polynomials_reduced + eliminated >= statistics.pairs_created);
+    assert(statistics.reduction_steps > 0);
+    assert(statistics.max_polynomial_length >= 3);
+    assert(statistics.max_coefficient_bits > 0 && statistics.max_coefficient_bits <= 5);
+    assert(!statistics.basis_size_history.empty());
+    assert(statistics.basis_size_history.back().second == F.size());
+    assert(statistics.phase_seconds[size_t(Phase::kGetS)] > 0);
+    assert(statistics.phase_seconds[size_t(Phase::kReduce)] > 0);
+    assert(statistics.phase_seconds[size_t(Phase::kAutoReduce)] > 0);
+
+    std::cout << "Statistics tests passed" << std::endl;
+}
+
+void Tests::test_tracer() {
+    using DegLex = OrderSum<DegOrder, LexOrder>;
+
+    using Value = Modular<17ll>;
+    using Poly = Polynomial<Value>;
+    using Set = PolynomialSet<Value>;
+
+    Set F = {Poly("1ab-1d"), Poly("1ac-1d"), Poly("1a^2+1b^2+1c^2")};
+    Statistics statistics;
+    Tracer tracer;
+    CombinedMonitor<Statistics, Tracer> monitor(&statistics, &tracer);
+    Algorithm::extend_to_grobners_basis<DegLex>(&F, &monitor);
+
+    auto events = tracer.get_events();
+    assert(tracer.get_dropped_count() == 0);
+    int depth = 0;
+    size_t reductions = 0;
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (events[i].type == Tracer::EventType::kBegin) {
+            ++depth;
+        } else if (events[i].type == Tracer::EventType::kEnd) {
+            --depth;
+            if (std::string(events[i].name) == "reduce_s") {
+                ++reductions;
+            }
+        }
+        assert(depth >= 0);
+        assert(i == 0 || events[i - 1].timestamp <= events[i].timestamp);
+    }
+    assert(depth == 0);
+    assert(reductions == statistics.s_polynomials_reduced);
+
+    Tracer ring(10);
+    for (int i = 0; i < 25; ++i) {
+        ring.record(Tracer::EventType::kInstant, "event", i);
+    }
+    events = ring.get_events();
+    assert(events.size() == 10);
+    assert(ring.get_dropped_count() == 15);
+    assert(events.front().value == 15 && events.back().value == 24);
+
+    std::stringstream ss;
+    ring.write_chrome_json(ss);
+    assert(ss.str().find("\"ph\": \"i\"") != std::string::npos);
+
+    std::cout << "Tracer tests passed" << std::endl;
+}
+
+void Tests::test_serialization() {
+    using Value = boost::rational<boost::multiprecision::cpp_int>;
+    using Poly = Polynomial<Value>;
+    using Set = PolynomialSet<Value>;
+
+    Monomial m;
+    m.set_degree(40, 3);
+    m.set_degree(2, -1);
+    Poly f("1/3ab^2-5/7c");
+    f.add_monomial(m, Value(boost::multiprecision::cpp_int("123456789012345678901234567890"), 7));
+    Set F = {f, Poly("2/1a") + Poly(Value(1)), Poly()};
+
+    std::stringstream ss;
+    Serializer<Set>::write(ss, F);
+    assert(Serializer<Set>::read(ss) == F);
+
+    std::stringstream modular_ss;
+    Serializer<Polynomial<Modular<17ll>>>::write(modular_ss, Polynomial<Modular<17ll>>("3ab+16c"));
+    assert(Serializer<Polynomial<Modular<17ll>>>::read(modular_ss) == Polynomial<Modular<17ll>>("3ab-1c"));
+
+    Statistics statistics;
+    statistics.pairs_created = 5;
+    statistics.pairs_eliminated[size_t(PairCriterion::kDuplicate)] = 2;
+    statistics.basis_size_history = {{0, 3}, {4, 5}};
+    std::stringstream statistics_ss;
+    Serializer<Statistics>::write(statistics_ss, statistics);
+    auto statistics_read = Serializer<Statistics>::read(statistics_ss);
+    assert(statistics_read.pairs_created == 5);
+    assert(statistics_read.pairs_eliminated[size_t(PairCriterion::kDuplicate)] == 2);
+    assert(statistics_read.basis_size_history == statistics.basis_size_history);
+
+    std::stringstream broken("3 1 2");
+    bool thrown = false;
+    try {
+        Serializer<Set>::read(broken);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::stringstream zero_denominator("1 1 0 0");
+    thrown = false;
+    try {
+        Serializer<Poly>::read(zero_denominator);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "Serialization tests passed" << std::endl;
+}
+
+void Tests::test_checkpoint() {
+    using DegLex = OrderSum<DegOrder, LexOrder>;
+
+    using Value = boost::rational<boost::multiprecision::cpp_int>;
+    using Poly = Polynomial<Value>;
+    using Set = PolynomialSet<Value>;
+
+    const std::string path = "grobner_test_checkpoint.txt";
+    // cpp_int can't read a leading '+', so the last generator is built by hand
+    Set generators = {Poly("1/1ab-1/1d"), Poly("2/1ac-1/1d"), Poly("1/1a^2") + Poly("3/1b^2") + Poly("1/1c^2")};
+
+    Set expected = generators;
+    Algorithm::extend_to_grobners_basis<DegLex>(&expected);
+
+    // periodic checkpoints during a full run, then resume from the last one
+    Set F = generators;
+    Statistics statistics;
+    Checkpointer<DegLex> checkpointer(path, 2, 0, &statistics);
+    CombinedMonitor<Statistics, Checkpointer<DegLex>> monitor(&statistics, &checkpointer);
+    Algorithm::extend_to_grobners_basis<DegLex>(&F, &monitor);
+    assert(F == expected);
+    assert(checkpointer.get_checkpoint_count() > 0);
+
+    auto checkpoint = Checkpoint<Value>::load(path);
+    assert(checkpoint.has_statistics);
+    assert(checkpoint.statistics.pairs_created <= statistics.pairs_created);
+    Set resumed;
+    checkpoint.resume<DegLex>(&resumed);
+    assert(resumed == expected);
+
+    // state right before the main loop
+    Set set_of_s;
+    for (auto it = generators.pbegin(); it != generators.pend(); ++it) {
+        set_of_s.insert(Algorithm::get_S<DegLex>(it.first(), it.second()));
+    }
+    Checkpoint<Value>::save<DegLex>(path, generators, set_of_s);
+    checkpoint = Checkpoint<Value>::load(path);
+    assert(!checkpoint.has_statistics);
+    checkpoint.resume<DegLex>(&resumed);
+    assert(resumed == expected);
+
+    // a checkpoint of another order or field is rejected
+    checkpoint = Checkpoint<Value>::load(path);
+    bool thrown = false;
+    try {
+        checkpoint.resume<LexOrder>(&resumed);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    thrown = false;
+    try {
+        Checkpoint<Modular<1'000'000'007ll>>::load(path);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::remove(path.c_str());
+
+    std::cout << "Checkpoint tests passed" << std::endl;
+}
+
+void Tests::test_fraction_free() {
+    using Lex = LexOrder;
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    using Integer = FractionFreeAlgorithm::Integer;
+    using Value = FractionFreeAlgorithm::Rational;
+    using Poly = Polynomial<Value>;
+    using Set = PolynomialSet<Value>;
+
+    auto f = FractionFreeAlgorithm::to_primitive(Poly("1/2ab-3/4c") + Poly("3/2"));
+    assert(f == Polynomial<Integer>("2ab-3c") + Polynomial<Integer>("6"));
+    assert(FractionFreeAlgorithm::get_content(Polynomial<Integer>("6ab-9c")) == 3);
+
+    auto g = Polynomial<Integer>("-6ab") + Polynomial<Integer>("9c");
+    FractionFreeAlgorithm::normalize<Lex>(&g);
+    assert(g == Polynomial<Integer>("2ab-3c"));
+
+    for (const auto& system : {BenchmarkSystems::get_cyclic<Value>(4), BenchmarkSystems::get_katsura<Value>(2),
+                               BenchmarkSystems::get_noon<Value>(2), Set{Poly("1/2ab-1/3d"), Poly("2/1ac-5/1d")}}) {
+        Set expected = system;
+        Algorithm::extend_to_grobners_basis<DegRevLex>(&expected);
+        Set F = system;
+        Statistics statistics;
+        FractionFreeAlgorithm::extend_to_grobners_basis<DegRevLex>(&F, &statistics);
+        assert(F == expected);
+    }
+
+    std::cout << "FractionFree tests passed" << std::endl;
+}
+
+void Tests::test_hybrid_rational() {
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    using Value = HybridRational;
+    using BigValue = HybridRational::BigRational;
+    using Integer = HybridRational::Integer;
+
+    const long long max_value = std::numeric_limits<long long>::max();
+
+    assert(Value(2, 4) == Value(1, 2));
+    assert(Value(3, -6) == Value(-1, 2));
+    assert(Value(1, 2) + Value(1, 3) == Value(5, 6));
+    assert(Value(1, 2) - Value(1, 2) == Value(0));
+    assert(Value(2, 3) * Value(9, 4) == Value(3, 2));
+    assert(Value(2, 3) / Value(-4, 9) == Value(-3, 2));
+    assert(-Value(5, 7) == Value(-5, 7));
+    assert(Value(0, 5).get_small_denominator() == 1);
+
+    // overflow promotes to cpp_int and the result is demoted back when it fits again
+    Value big = Value(max_value) + Value(1);
+    assert(!big.is_small());
+    assert(big.get_numerator() == Integer(max_value) + 1);
+    assert(big == Value(BigValue(Integer(max_value) + 1)));
+    assert((big - Value(1)).is_small());
+    assert(big - Value(1) == Value(max_value));
+    Value square = Value(max_value) * Value(max_value);
+    assert(!square.is_small());
+    assert(square / Value(max_value) == Value(max_value));
+    assert(Value(1, max_value) + Value(1, max_value - 1) ==
+           Value(BigValue(Integer(2) * max_value - 1, Integer(max_value) * (max_value - 1))));
+    assert(-Value(-max_value) == Value(max_value));
+    assert(!(Value(-max_value) - Value(1)).is_small());
+
+    std::stringstream ss;
+    ss << Value(-3, 4) << ' ' << square;
+    Value read_small, read_big;
+    ss >> read_small >> read_big;
+    assert(read_small == Value(-3, 4));
+    assert(read_big == square);
+    assert(hash<Value>()(read_big) == hash<Value>()(square));
+
+    assert(Polynomial<Value>("1/2ab-3/4c") * Value(4) == Polynomial<Value>("2ab-3c"));
+    assert(Polynomial<Value>("+5a") == Polynomial<Value>("5/1a"));
+
+    for (int n : {3, 4}) {
+        auto system = BenchmarkSystems::get_cyclic<Value>(n);
+        Algorithm::extend_to_grobners_basis<DegRevLex>(&system);
+        auto expected = BenchmarkSystems::get_cyclic<BigValue>(n);
+        Algorithm::extend_to_grobners_basis<DegRevLex>(&expected);
+        PolynomialSet<BigValue> converted;
+        for (const auto& f : system) {
+            Polynomial<BigValue> g;
+            for (const auto& [monomial, coefficient] : f) {
+                g.add_monomial(monomial, coefficient.get_big());
+            }
+            converted.insert(g);
+        }
+        assert(converted == expected);
+    }
+
+    std::cout << "HybridRational tests passed" << std::endl;
+}
+
+void Tests::test_allocations() {
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    using Value = Modular<1'000'000'007ll>;
+    using Poly = Polynomial<Value>;
+    using Set = PolynomialSet<Value>;
+
+    auto count_allocations = [](auto function) {
+        size_t before = AllocationCounter::get_allocation_count();
+        function();
+        return AllocationCounter::get_allocation_count() - before;
+    };
+    if (!AllocationCounter::is_enabled()) {
+        std::cout << "Allocation tests skipped, allocation_counter.cpp is not linked" << std::endl;
+        return;
+    }
+
+    Poly f("1ab+2bc+3c^2+4d");
+    Poly g("5ab+6d");
+    Poly result;
+    assert(count_allocations([&]() { result = std::move(f) * Value(3); }) == 0);
+    assert(count_allocations([&]() { result = std::move(result) + g; }) == 0);
+    assert(count_allocations([&]() { result = std::move(result) - g * Value(2); }) <= 2 * g.size() + 1);
+    assert(result == Poly("3ab+6bc+9c^2+12d") - g);
+
+    Set F = {Poly("1a+1b"), Poly("1b+1c"), Poly("1c+1d")};
+    assert(count_allocations([&]() {
+        for (auto it = F.pbegin(); it != F.pend(); ++it) {
+            assert(!it.first().is_zero() && !(*it).second.is_zero());
+        }
+    }) == 0);
+    assert(count_allocations([&]() { result = F.retrieve_first(); }) == 0);
+    assert(count_allocations([&]() { F.insert(std::move(result)); }) == 1);
+
+    // reference run, the number was about three times larger when the algorithm copied polynomials
+    auto system = BenchmarkSystems::get_cyclic<Value>(4);
+    assert(count_allocations([&]() { Algorithm::extend_to_grobners_basis<DegRevLex>(&system); }) < 2000);
+
+    std::cout << "Allocation tests passed" << std::endl;
+}
+
+void Tests::test_modular_pair_filter() {
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    using Value = boost::rational<boost::multiprecision::cpp_int>;
+    using Poly = Polynomial<Value>;
+    using Set = PolynomialSet<Value>;
+    using Image = ModularImage<17ll>;
+
+    Modular<17ll> image;
+    assert(Image::get(Value(3, 5), &image) && image == Modular<17ll>(3) / Modular<17ll>(5));
+    assert(Image::get(Value(-1, 2), &image) && image == Modular<17ll>(8));
+    assert(!Image::get(Value(1, 34), &image));
+    assert(Image::get(HybridRational(20, 3), &image) && image == Modular<17ll>(1));
+    Polynomial<Modular<17ll>> polynomial_image;
+    assert(Image::get(Poly("1/2ab-3/4c"), &polynomial_image) && polynomial_image == Polynomial<Modular<17ll>>("9ab+12c"));
+    assert(!Image::get(Poly("1/17ab"), &polynomial_image));
+
+    for (const auto& system : {BenchmarkSystems::get_cyclic<Value>(4), BenchmarkSystems::get_katsura<Value>(2),
+                               BenchmarkSystems::get_eco<Value>(4), Set{Poly("1/2ab-1/3d"), Poly("2/1ac-5/1d")}}) {
+        Set expected = system;
+        Algorithm::extend_to_grobners_basis<DegRevLex>(&expected);
+
+        Set F = system;
+        Statistics statistics;
+        ModularPairFilter<> verifying_filter(1);
+        Algorithm::extend_to_grobners_basis<DegRevLex>(&F, &statistics, &verifying_filter);
+        assert(F == expected);
+        assert(verifying_filter.get_skipped_count() == 0);
+        assert(verifying_filter.get_verified_count() == verifying_filter.get_zero_count());
+        assert(verifying_filter.get_false_zero_count() == 0);
+
+        F = system;
+        statistics = Statistics();
+        ModularPairFilter<> filter;
+        Algorithm::extend_to_grobners_basis<DegRevLex>(&F, &statistics, &filter);
+        assert(F == expected);
+        assert(statistics.pairs_eliminated[size_t(PairCriterion::kFiltered)] == filter.get_skipped_count());
+        assert(filter.is_result_proven() == (filter.get_skipped_count() == 0));
+    }
+
+    // S(a^2+17b, ab) = 17b^2 is zero modulo 17 but not over Q
+    Set system = {Poly("1/1a^2") + Poly("17/1b"), Poly("1/1ab")};
+    Set expected = system;
+    Algorithm::extend_to_grobners_basis<DegRevLex>(&expected);
+
+    Set F = system;
+    Statistics statistics;
+    ModularPairFilter<17ll> verifying_filter(1);
+    Algorithm::extend_to_grobners_basis<DegRevLex>(&F, &statistics, &verifying_filter);
+    assert(F == expected);
+    assert(verifying_filter.get_false_zero_count() == 1);
+    assert(verifying_filter.is_disabled() && verifying_filter.is_result_proven());
+
+    F = system;
+    ModularPairFilter<17ll> filter(0);
+    Algorithm::extend_to_grobners_basis<DegRevLex>(&F, &statistics, &filter);
+    assert(F != expected);
+    assert(!filter.is_disabled() && !filter.is_result_proven());
+
+    // with every second drop verified, S(a^2+17b, ab) is dropped unchecked and a later false zero
+    // switches the filter off; ModularFilteredAlgorithm recovers the dropped S-polynomials
+    system = {Poly("1/1a^2") + Poly("17/1b"), Poly("1/1ab"), Poly("1/1b^2") + Poly("17/1c"), Poly("1/1bc")};
+    expected = system;
+    Algorithm::extend_to_grobners_basis<DegRevLex>(&expected);
+    F = system;
+    ModularPairFilter<17ll> unrecovered_filter(2);
+    Algorithm::extend_to_grobners_basis<DegRevLex>(&F, &statistics, &unrecovered_filter);
+    assert(unrecovered_filter.is_disabled() && unrecovered_filter.get_skipped_count() > 0 && F != expected);
+    F = system;
+    ModularPairFilter<17ll> recovered_filter(2);
+    assert(ModularFilteredAlgorithm::extend_to_grobners_basis<DegRevLex>(&F, &statistics, &recovered_filter));
+    assert(recovered_filter.is_disabled() && F == expected);
+
+    std::cout << "ModularPairFilter tests passed" << std::endl;
+}
+
+void Tests::test_dyn_modular() {
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    PrimeField field(17);
+    {
+        DynModular::FieldScope scope(field);
+
+        assert(DynModular(15) + 16 == DynModular(14));
+        assert(15 + DynModular(16) == DynModular(14));
+        assert(DynModular(2) == DynModular(-15));
+        assert(DynModular(36) == DynModular(-15));
+        assert(DynModular(1) != DynModular(-1));
+        assert(DynModular(34) - DynModular(3) + DynModular(5) == DynModular(2));
+        assert(-DynModular(5) == DynModular(-5));
+        assert(-DynModular(0) == DynModular(0));
+
+        assert(DynModular(1958) * DynModular(-16) == DynModular(1958));
+        assert(DynModular(5) * DynModular(7) == DynModular(1));
+        assert(DynModular(5).get_inverse() == DynModular(7));
+        assert(DynModular(2) / DynModular(7) == DynModular(10));
+        assert(DynModular(12345).get_pow(1600000000) == DynModular(1));
+        assert(DynModular(56789).get_pow(-123) == DynModular(56789).get_pow(123).get_inverse());
+
+        std::stringstream ss;
+        ss << 36 << ' ' << -8;
+        DynModular m1, m2;
+        ss >> m1 >> m2;
+        assert(m1 == DynModular(2));
+        assert(m2 == DynModular(9));
+
+        // scopes nest
+        PrimeField other_field(5);
+        {
+            DynModular::FieldScope other_scope(other_field);
+            assert(DynModular(7).get_value() == 2);
+        }
+        assert(DynModular(7).get_value() == 7);
+
+        assert(Polynomial<DynModular>("2a+3b^2") / DynModular(5) == Polynomial<DynModular>("14a+4b^2"));
+    }
+
+    // Barrett reduction near the largest supported modulus
+    PrimeField large_field(4'294'967'291ll);
+    {
+        DynModular::FieldScope scope(large_field);
+        DynModular a(4'294'967'290ll);
+        assert(a * a == DynModular(1));
+        assert(a.get_inverse() == a);
+        assert(DynModular(123'456'789).get_pow(4'294'967'290ll) == DynModular(1));
+    }
+
+    // the same bases as with Modular<P>
+    auto check_prime = [](auto expected_modular) {
+        using Modular = decltype(expected_modular);
+        PrimeField field(Modular(-1).get_value() + 1);
+        DynModular::FieldScope scope(field);
+
+        for (int size : {3, 4}) {
+            auto expected = BenchmarkSystems::get_cyclic<Modular>(size);
+            Algorithm::extend_to_grobners_basis<DegRevLex>(&expected);
+            PolynomialSet<DynModular> converted;
+            for (const auto& f : expected) {
+                Polynomial<DynModular> g;
+                for (const auto& [monomial, coefficient] : f) {
+                    g.add_monomial(monomial, DynModular(coefficient.get_value()));
+                }
+                converted.insert(std::move(g));
+            }
+
+            auto F = BenchmarkSystems::get_cyclic<DynModular>(size);
+            Algorithm::extend_to_grobners_basis<DegRevLex>(&F);
+            assert(F == converted);
+        }
+    };
+    check_prime(Modular<17ll>());
+    check_prime(Modular<1'000'000'007ll>());
+    check_prime(Modular<2'147'483'647ll>());
+
+    std::cout << "DynModular tests passed" << std::endl;
+}
+
+void Tests::test_trace_replay() {
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    using Value = boost::rational<long long>;
+    using Poly = Polynomial<Value>;
+    using Set = PolynomialSet<Value>;
+    using Modular = Modular<1'000'000'007ll>;
+
+    // learning computes the same basis as Algorithm
+    for (const auto& system : {BenchmarkSystems::get_cyclic<Modular>(4), BenchmarkSystems::get_katsura<Modular>(3),
+                               BenchmarkSystems::get_random_dense<Modular>(3, 2, 0)}) {
+        auto expected = system;
+        Algorithm::extend_to_grobners_basis<DegRevLex>(&expected);
+        auto F = system;
+        auto trace = TraceReplayAlgorithm::learn<DegRevLex>(&F);
+        assert(F == expected);
+        F = system;
+        assert(TraceReplayAlgorithm::replay<DegRevLex>(trace, &F));
+        assert(F == expected);
+    }
+
+    // other coefficients: replayed iff no coefficient is zero, i.e. all 10 monomials are present
+    {
+        auto F = BenchmarkSystems::get_random_dense<Modular>(3, 2, 0);
+        auto trace = TraceReplayAlgorithm::learn<DegRevLex>(&F);
+        size_t replayed_count = 0;
+        for (unsigned seed = 1; seed <= 10; ++seed) {
+            auto system = BenchmarkSystems::get_random_dense<Modular>(3, 2, seed);
+            bool is_dense = std::all_of(system.begin(), system.end(), [](const auto& f) { return f.size() == 10; });
+            auto expected = system;
+            Algorithm::extend_to_grobners_basis<DegRevLex>(&expected);
+            Statistics statistics;
+            bool is_replayed = TraceReplayAlgorithm::extend_to_grobners_basis<DegRevLex>(trace, &system, &statistics);
+            assert(is_replayed == is_dense);
+            assert(system == expected);
+            replayed_count += is_replayed;
+        }
+        assert(replayed_count > 0);
+    }
+
+    // different shapes are detected, extend_to_grobners_basis falls back to Algorithm
+    {
+        Set F{Poly("1/1a-2/1b"), Poly("1/1a+3/1b")};
+        auto trace = TraceReplayAlgorithm::learn<LexOrder>(&F);
+        assert(F == Set({Poly("1/1a"), Poly("1/1b")}));
+
+        for (const auto& system : {Set{Poly("1/1a-2/1b"), Poly("2/1a-4/1b")}, Set{Poly("1/1a-2/1b"), Poly("1/1a+3/1c")},
+                                   Set{Poly("1/1a-2/1b")}}) {
+            Set G = system;
+            assert(!TraceReplayAlgorithm::replay<LexOrder>(trace, &G));
+            assert(G == system);
+            Set expected = system;
+            Algorithm::extend_to_grobners_basis<LexOrder>(&expected);
+            assert(!TraceReplayAlgorithm::extend_to_grobners_basis<LexOrder>(trace, &G));
+            assert(G == expected);
+        }
+        Set G{Poly("5/1a-1/1b"), Poly("1/2a+1/1b")};
+        assert(TraceReplayAlgorithm::extend_to_grobners_basis<LexOrder>(trace, &G));
+        assert(G == Set({Poly("1/1a"), Poly("1/1b")}));
+    }
+
+    // the zero reductions of learn are checked: S(ab + 6c, ac + 2b) = 6c^2 - 2b^2 reduces to zero
+    // by b^2 - 3c^2 only because 6 = 2 * 3, with 5c instead of 6c all supports stay the same
+    {
+        using ModularPoly = Polynomial<Modular>;
+        using ModularSet = PolynomialSet<Modular>;
+
+        ModularSet F{ModularPoly("1ab+6c"), ModularPoly("1ac+2b"), ModularPoly("1b^2-3c^2")};
+        auto trace = TraceReplayAlgorithm::learn<DegRevLex>(&F);
+        assert(!trace.zero_steps.empty());
+
+        ModularSet system{ModularPoly("1ab+5c"), ModularPoly("1ac+2b"), ModularPoly("1b^2-3c^2")};
+        auto G = system;
+        assert(!TraceReplayAlgorithm::replay<DegRevLex>(trace, &G));
+        assert(G == system);
+        auto expected = system;
+        Algorithm::extend_to_grobners_basis<DegRevLex>(&expected);
+        assert(!TraceReplayAlgorithm::extend_to_grobners_basis<DegRevLex>(trace, &G));
+        assert(G == expected);
+    }
+
+    // a^3 + ab + 1 and a^3 + a + b have the same leading monomial, term count and sum of degrees
+    {
+        assert(TraceReplayAlgorithm::get_support<LexOrder>(Poly("1/1a^3+1/1ab+1/1")) !=
+               TraceReplayAlgorithm::get_support<LexOrder>(Poly("1/1a^3+1/1a+1/1b")));
+
+        Set F{Poly("1/1a^3+2/1ab+3/1"), Poly("1/1b^2-1/1a")};
+        auto trace = TraceReplayAlgorithm::learn<LexOrder>(&F);
+        Set system{Poly("1/1a^3+2/1a+3/1b"), Poly("1/1b^2-1/1a")};
+        auto G = system;
+        assert(!TraceReplayAlgorithm::replay<LexOrder>(trace, &G));
+        assert(G == system);
+    }
+
+    std::cout << "TraceReplay tests passed" << std::endl;
+}
+
+void Tests::test_multi_prime() {
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    using Value = boost::rational<boost::multiprecision::cpp_int>;
+    using Poly = Polynomial<Value>;
+    using Set = PolynomialSet<Value>;
+
+    assert(MultiPrime::get_primes(3, 100) == std::vector<long long>({97, 89, 83}));
+
+    auto system = BenchmarkSystems::get_katsura<Value>(3);
+    auto expected = system;
+    Algorithm::extend_to_grobners_basis<DegRevLex>(&expected);
+
+    auto primes = MultiPrime::get_primes(8);
+    auto images = MultiPrime::compute_on_threads<DegRevLex>(system, primes, 3);
+    assert(images.size() == primes.size());
+    for (size_t i = 0; i < primes.size(); ++i) {
+        assert(images[i].prime == primes[i] && images[i].is_valid);
+    }
+    MultiPrime::Integer modulus;
+    PolynomialSet<MultiPrime::Integer> combined;
+    assert(MultiPrime::combine<DegRevLex>(images, &combined, &modulus));
+    Set reconstructed;
+    assert(MultiPrime::reconstruct(combined, modulus, &reconstructed));
+    assert(reconstructed == expected);
+
+    // worker processes compute the same images
+    auto process_images = MultiPrime::compute_in_processes<DegRevLex>(system, primes, 3);
+    for (size_t i = 0; i < primes.size(); ++i) {
+        assert(process_images[i].is_valid && process_images[i].basis == images[i].basis);
+    }
+
+    // PrimeField rejects the modulus 1, only its image is invalid in both drivers
+    auto bad_primes = primes;
+    bad_primes.insert(bad_primes.begin(), 1);
+    for (const auto& bad_images : {MultiPrime::compute_on_threads<DegRevLex>(system, bad_primes, 3),
+                                   MultiPrime::compute_in_processes<DegRevLex>(system, bad_primes, 3)}) {
+        assert(bad_images[0].prime == 1 && !bad_images[0].is_valid);
+        for (size_t i = 1; i < bad_primes.size(); ++i) {
+            assert(bad_images[i].is_valid && bad_images[i].basis == images[i - 1].basis);
+        }
+        assert(MultiPrime::combine<DegRevLex>(bad_images, &combined, &modulus));
+        assert(MultiPrime::reconstruct(combined, modulus, &reconstructed) && reconstructed == expected);
+    }
+
+    // a repeated prime would be counted twice in the modulus
+    std::vector<long long> duplicate_primes = {97, 89, 97};
+    bool thrown = false;
+    try {
+        MultiPrime::compute_on_threads<DegRevLex>(system, duplicate_primes);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    thrown = false;
+    try {
+        MultiPrime::compute_in_processes<DegRevLex>(system, duplicate_primes);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 97 divides a denominator, 89 changes the leading monomials, both are skipped
+    Set unlucky{Poly("1/97ab-1/1c"), Poly("89/1a^2-1/1b"), Poly("1/1b^2-1/1a")};
+    expected = unlucky;
+    Algorithm::extend_to_grobners_basis<DegRevLex>(&expected);
+    std::vector<long long> unlucky_primes = {97, 89, 83, 79, 73, 71, 67};
+    images = MultiPrime::compute_in_processes<DegRevLex>(unlucky, unlucky_primes, 2);
+    assert(!images[0].is_valid && images[1].is_valid);
+    assert(MultiPrime::combine<DegRevLex>(images, &combined, &modulus));
+    assert(modulus == MultiPrime::Integer(83) * 79 * 73 * 71 * 67);
+    assert(MultiPrime::reconstruct(combined, modulus, &reconstructed));
+    assert(reconstructed == expected);
+
+    std::cout << "MultiPrime tests passed" << std::endl;
+}
+
+void Tests::test_job_pool() {
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    using Value = boost::rational<boost::multiprecision::cpp_int>;
+    using Set = PolynomialSet<Value>;
+    using ModularValue = Modular<1'000'000'007ll>;
+
+    auto get_expected = [](auto system) {
+        Algorithm::extend_to_grobners_basis<DegRevLex>(&system);
+        return system;
+    };
+    auto is_aborted = [](auto* job, JobAborted::Reason reason) {
+        try {
+            job->get();
+        } catch (const JobAborted& error) {
+            return error.get_reason() == reason;
+        }
+        return false;
+    };
+
+    {
+        // jobs of different types are submitted from several threads to one pool
+        JobPool pool(2);
+        assert(pool.get_thread_count() == 2);
+        auto katsura = BenchmarkSystems::get_katsura<Value>(3);
+        auto modular_katsura = BenchmarkSystems::get_katsura<ModularValue>(3);
+        std::vector<Job<Value>> katsura_jobs;
+        std::vector<Job<ModularValue>> modular_jobs;
+        std::thread other_thread([&]() {
+            for (int i = 0; i < 3; ++i) {
+                modular_jobs.push_back(pool.submit<DegRevLex>(modular_katsura));
+            }
+        });
+        for (int i = 0; i < 3; ++i) {
+            katsura_jobs.push_back(pool.submit<DegRevLex>(katsura));
+        }
+        other_thread.join();
+        auto expected_katsura = get_expected(katsura);
+        auto expected_modular = get_expected(modular_katsura);
+        for (auto& job : katsura_jobs) {
+            assert(job.get() == expected_katsura);
+        }
+        for (auto& job : modular_jobs) {
+            assert(job.get() == expected_modular);
+        }
+    }
+
+    {
+        // with one worker a job of higher priority overtakes the queued ones
+        JobPool pool(1);
+        auto slow = BenchmarkSystems::get_katsura<Value>(3);
+        Set fast{Polynomial<Value>("1/1a-1/1b")};
+        auto first = pool.submit<DegRevLex>(slow);
+        auto low = pool.submit<DegRevLex>(slow);
+        JobOptions options;
+        options.priority = 1;
+        auto high = pool.submit<DegRevLex>(fast, options);
+        high.wait();
+        assert(!low.is_ready());
+        assert(high.get() == get_expected(fast));
+        low.cancel();
+        assert(is_aborted(&low, JobAborted::Reason::kCancelled));
+        first.wait();
+    }
+
+    {
+        JobPool pool(1);
+        auto system = BenchmarkSystems::get_katsura<Value>(4);
+        // cancelled while running
+        auto running = pool.submit<DegRevLex>(system);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        running.cancel();
+        assert(is_aborted(&running, JobAborted::Reason::kCancelled));
+
+        JobOptions options;
+        options.time_limit_seconds = 0.01;
+        auto timed = pool.submit<DegRevLex>(system, options);
+        assert(is_aborted(&timed, JobAborted::Reason::kTimeLimit));
+
+        options = JobOptions();
+        options.memory_limit_bytes = JobMonitor::estimate_bytes(system);
+        auto limited = pool.submit<DegRevLex>(system, options);
+        assert(is_aborted(&limited, JobAborted::Reason::kMemoryLimit));
+        assert(pool.get_queued_count() == 0);
+    }
+
+    std::cout << "JobPool tests passed" << std::endl;
+}
+
+void Tests::test_result_cache() {
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    using Value = boost::rational<boost::multiprecision::cpp_int>;
+    using Poly = Polynomial<Value>;
+    using Set = PolynomialSet<Value>;
+
+    // permuted and scaled generators have the same fingerprint, other orders and fields don't
+    Set F{Poly("1/1a^2-1/1b"), Poly("1/1ab-1/1c")};
+    Set G{Poly("2/1ab-2/1c"), Poly("1/3a^2-1/3b") * Value(-1), Poly("1/1ab-1/1c")};
+    assert(IdealFingerprint::get<DegRevLex>(F) == IdealFingerprint::get<DegRevLex>(G));
+    assert(IdealFingerprint::get<DegRevLex>(F) != IdealFingerprint::get<LexOrder>(F));
+    assert(IdealFingerprint::get<DegRevLex>(F) != IdealFingerprint::get<DegRevLex>(Set{Poly("1/1a^2-1/1b")}));
+    assert(IdealFingerprint::get<DegRevLex>(F) ==
+           IdealFingerprint::get<DegRevLex>(PolynomialSet<HybridRational>{Polynomial<HybridRational>("1/1a^2-1/1b"),
+                                                                         Polynomial<HybridRational>("1/1ab-1/1c")}));
+    assert(IdealFingerprint::get<DegRevLex>(F) !=
+           IdealFingerprint::get<DegRevLex>(PolynomialSet<Modular<1'000'000'007ll>>{
+               Polynomial<Modular<1'000'000'007ll>>("1/1a^2-1/1b"), Polynomial<Modular<1'000'000'007ll>>("1/1ab-1/1c")}));
+
+    auto expected = F;
+    Algorithm::extend_to_grobners_basis<DegRevLex>(&expected);
+    auto katsura = BenchmarkSystems::get_katsura<Value>(3);
+    auto expected_katsura = katsura;
+    Algorithm::extend_to_grobners_basis<DegRevLex>(&expected_katsura);
+    assert(ResultCache<Value>::is_verified<DegRevLex>(katsura, expected_katsura));
+    assert(!ResultCache<Value>::is_verified<DegRevLex>(katsura, F));
+    // a Grobner basis of a larger ideal, and a Grobner basis that is not reduced
+    assert(!ResultCache<Value>::is_verified<DegRevLex>(katsura, Set{Poly("1/1")}));
+    auto not_reduced = expected_katsura;
+    not_reduced.insert(*expected_katsura.begin() * Poly("1/1a"));
+    assert(!ResultCache<Value>::is_verified<DegRevLex>(katsura, not_reduced));
+
+    {
+        ResultCache<Value> cache(1);
+        auto result = F;
+        cache.extend_to_grobners_basis<DegRevLex>(&result);
+        assert(result == expected && cache.get_miss_count() == 1);
+        result = G;
+        cache.extend_to_grobners_basis<DegRevLex>(&result);
+        assert(result == expected && cache.get_memory_hit_count() == 1);
+        // the least recently used entry is evicted
+        result = katsura;
+        cache.extend_to_grobners_basis<DegRevLex>(&result);
+        assert(result == expected_katsura && cache.get_size() == 1);
+        result = F;
+        cache.extend_to_grobners_basis<DegRevLex>(&result);
+        assert(result == expected && cache.get_miss_count() == 3);
+    }
+
+    const std::string directory = ".";
+    const std::string path = directory + "/" + IdealFingerprint::get<DegRevLex>(katsura) + ".gb";
+    {
+        ResultCache<Value> cache(4, directory);
+        auto result = katsura;
+        cache.extend_to_grobners_basis<DegRevLex>(&result);
+        assert(cache.get_miss_count() == 1);
+    }
+    {
+        // a new cache finds the basis on disk, then in memory
+        ResultCache<Value> cache(4, directory, true);
+        for (int i = 0; i < 2; ++i) {
+            auto result = katsura;
+            cache.extend_to_grobners_basis<DegRevLex>(&result);
+            assert(result == expected_katsura);
+        }
+        assert(cache.get_disk_hit_count() == 1 && cache.get_memory_hit_count() == 1 && cache.get_miss_count() == 0);
+    }
+    {
+        // a wrong basis in the file is rejected by verification and overwritten
+        ResultCache<Value>(0, directory).insert<DegRevLex>(katsura, F);
+        ResultCache<Value> cache(4, directory, true);
+        auto result = katsura;
+        cache.extend_to_grobners_basis<DegRevLex>(&result);
+        assert(result == expected_katsura && cache.get_rejected_count() == 1 && cache.get_miss_count() == 1);
+        PolynomialSet<Value> stored;
+        assert(ResultCache<Value>(0, directory).find<DegRevLex>(katsura, &stored) && stored == expected_katsura);
+    }
+    {
+        // so is the basis of the whole ring, which contains every generator
+        ResultCache<Value>(0, directory).insert<DegRevLex>(katsura, Set{Poly("1/1")});
+        ResultCache<Value> cache(4, directory, true);
+        auto result = katsura;
+        cache.extend_to_grobners_basis<DegRevLex>(&result);
+        assert(result == expected_katsura && cache.get_rejected_count() == 1);
+    }
+    {
+        // a corrupted file is a miss, here the coefficient 1/0
+        auto canonical_text = IdealFingerprint::get_canonical_text<DegRevLex>(katsura);
+        std::ofstream(path) << "grobner_cache 1\ninput " << canonical_text.size() << '\n' << canonical_text
+                            << "basis 1\n1 1 0 0\nend\n";
+        ResultCache<Value> cache(4, directory);
+        auto result = katsura;
+        cache.extend_to_grobners_basis<DegRevLex>(&result);
+        assert(result == expected_katsura && cache.get_miss_count() == 1);
+    }
+    std::remove(path.c_str());
+
+    std::cout << "ResultCache tests passed" << std::endl;
+}
+
+void Tests::test_boolean_ring() {
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+    using Poly = BooleanPolynomial<DegRevLex>;
+    using Basis = std::vector<Poly>;
+
+    assert(BooleanMonomial("ab") * BooleanMonomial("bc") == BooleanMonomial("abc"));
+    assert(BooleanMonomial("a^3b") == BooleanMonomial("ab"));
+    assert(BooleanMonomial("abc") / BooleanMonomial("b") == BooleanMonomial("ac"));
+    assert(BooleanMonomial("abc").is_divisible_by(BooleanMonomial("ac")));
+    assert(!BooleanMonomial("ab").is_divisible_by(BooleanMonomial("c")));
+    assert(BooleanMonomial("ab").is_coprime_with(BooleanMonomial("cd")));
+    assert(BooleanMonomial({1, 100}).get_degree() == 2 && BooleanMonomial({1, 100}).has_variable(100));
+    assert(BooleanMonomial({1, 100}) / BooleanMonomial({100}) == BooleanMonomial("b"));
+    assert(BooleanOrder<DegRevLex>()(BooleanMonomial("a"), BooleanMonomial("b")));
+    assert(BooleanOrder<DegRevLex>()(BooleanMonomial("ad"), BooleanMonomial("bc")));
+    assert(BooleanOrder<LexOrder>()(BooleanMonomial("bc"), BooleanMonomial("a")));
+
+    assert(Poly("ab+c") + Poly("c+1") == Poly("ab+1"));
+    assert(Poly("a+b+a") == Poly("b"));
+    assert(Poly("a+b") * Poly("a+b") == Poly("a+b"));
+    assert((Poly("a+1") * Poly("a")).is_zero());
+    assert(Poly("b+1+ab").get_leading_monomial() == BooleanMonomial("ab"));
+    assert(Poly("ab+c") * BooleanMonomial("a") == Poly("ab+ac"));
+
+    assert((BooleanAlgorithm::eliminate<DegRevLex>(Basis{"ab+a", "ab+b", "a+b"}) == Basis{"ab+a", "a+b"}));
+
+    // ab = 1 only for a = b = 1
+    Basis F{"ab+1"};
+    BooleanAlgorithm::extend_to_grobners_basis<DegRevLex>(&F);
+    assert((F == Basis{"a+1", "b+1"}));
+
+    F = {"ab+1", "a+b+1"};
+    BooleanAlgorithm::extend_to_grobners_basis<DegRevLex>(&F);
+    assert((F == Basis{"1"}));
+
+    // the same as the Grobner basis over GF(2) with the field equations x^2 + x
+    using Value = Modular<2ll>;
+    auto to_polynomial = [](const auto& f) {
+        Polynomial<Value> result;
+        for (const auto& term : f) {
+            Monomial monomial;
+            for (auto variable : term.get_variables()) {
+                monomial.set_degree(variable, 1);
+            }
+            result += Polynomial<Value>(monomial);
+        }
+        return result;
+    };
+    std::vector<Polynomial<Value>> field_equations;
+    for (size_t i = 0; i < 5; ++i) {
+        Monomial square, variable;
+        square.set_degree(i, 2);
+        variable.set_degree(i, 1);
+        field_equations.push_back(Polynomial<Value>(square) + Polynomial<Value>(variable));
+    }
+    for (auto F : {Basis{"abc+ad+1", "bd+c", "ac+bd+d"}, Basis{"ab+cd+e", "ace+b+1", "bc+de+a"}}) {
+        PolynomialSet<Value> G;
+        for (const auto& equation : field_equations) {
+            G.insert(equation);
+        }
+        for (const auto& f : F) {
+            G.insert(to_polynomial(f));
+        }
+        Algorithm::extend_to_grobners_basis<DegRevLex>(&G);
+        // the field equations left in the basis are implicit in the boolean ring
+        PolynomialSet<Value> expected;
+        for (const auto& g : G) {
+            if (std::find(field_equations.begin(), field_equations.end(), g) == field_equations.end()) {
+                expected.insert(g);
+            }
+        }
+
+        BooleanAlgorithm::extend_to_grobners_basis<DegRevLex>(&F);
+        PolynomialSet<Value> result;
+        for (const auto& f : F) {
+            result.insert(to_polynomial(f));
+        }
+        assert(result == expected);
+    }
+
+    std::cout << "BooleanRing tests passed" << std::endl;
+}
+
+void Tests::test_small_modular() {
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    assert(SmallModular<17>(15) + 16 == SmallModular<17>(14));
+    assert(SmallModular<17>(2) == SmallModular<17>(-15));
+    assert(-SmallModular<17>(0) == SmallModular<17>(0));
+    assert(SmallModular<17>(5).get_inverse() == SmallModular<17>(7));
+    assert(SmallModular<17>(12345).get_pow(1600000000) == SmallModular<17>(1));
+    assert(SmallModular<17>(0).get_pow(0) == SmallModular<17>(1) && SmallModular<17>(0).get_pow(5) == SmallModular<17>(0));
+    assert(SmallModular<2>(1) + 1 == SmallModular<2>(0) && SmallModular<2>(1).get_inverse() == SmallModular<2>(1));
+    assert(CoefficientSize<SmallModular<65521>>::get_bits(SmallModular<65521>(65520)) == 16);
+
+    // all operations agree with Modular<P>
+    auto check_prime = [](auto prime_constant) {
+        constexpr long long prime = decltype(prime_constant)::value;
+        using Small = SmallModular<prime>;
+        using Modular = Modular<prime>;
+        for (long long a = 0; a < prime; a += 1 + prime / 300) {
+            for (long long b = 0; b < prime; b += 1 + prime / 200) {
+                assert((Small(a) + Small(b)).get_value() == (Modular(a) + Modular(b)).get_value());
+                assert((Small(a) - Small(b)).get_value() == (Modular(a) - Modular(b)).get_value());
+                assert((Small(a) * Small(b)).get_value() == (Modular(a) * Modular(b)).get_value());
+                if (b != 0) {
+                    assert((Small(a) / Small(b)).get_value() == (Modular(a) / Modular(b)).get_value());
+                }
+            }
+            assert(Small(a).get_pow(-12345).get_value() == Modular(a).get_pow(-12345).get_value() || a == 0);
+        }
+
+        auto expected = BenchmarkSystems::get_katsura<Modular>(3);
+        Algorithm::extend_to_grobners_basis<DegRevLex>(&expected);
+        auto F = BenchmarkSystems::get_katsura<Small>(3);
+        Algorithm::extend_to_grobners_basis<DegRevLex>(&F);
+        PolynomialSet<Small> converted;
+        for (const auto& f : expected) {
+            Polynomial<Small> g;
+            for (const auto& [monomial, coefficient] : f) {
+                g.add_monomial(monomial, Small(coefficient.get_value()));
+            }
+            converted.insert(std::move(g));
+        }
+        assert(F == converted);
+    };
+    check_prime(std::integral_constant<long long, 17>());
+    check_prime(std::integral_constant<long long, 32003>());
+    check_prime(std::integral_constant<long long, 65521>());
+
+    std::cout << "SmallModular tests passed" << std::endl;
+}
+
+void Tests::test_sparse_monomial() {
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    assert(SparseMonomial("a^2c") * SparseMonomial("bc^3") == SparseMonomial("a^2bc^4"));
+    assert(SparseMonomial("a^2bc^4") / SparseMonomial("bc^3") == SparseMonomial("a^2c"));
+    assert(SparseMonomial("ab") / SparseMonomial("ab") == SparseMonomial());
+    assert(SparseMonomial({0, 3, 0, 1}) == SparseMonomial("b^3d"));
+    assert(SparseMonomial("b^3d").get_degree() == 4 && SparseMonomial("b^3d").get_degree(1) == 3);
+    assert(SparseMonomial("b^3d").container_size() == 4);
+    assert(SparseMonomial("a^2bc").is_divisible_by(SparseMonomial("ac")));
+    assert(!SparseMonomial("a^2bc").is_divisible_by(SparseMonomial("c^2")));
+    assert(!SparseMonomial("a^2bc").is_divisible_by(SparseMonomial("d")));
+    assert(Algorithm::get_LCM(SparseMonomial("a^2c"), SparseMonomial("ab^3c^2")) == SparseMonomial("a^2b^3c^2"));
+
+    SparseMonomial monomial;
+    monomial.set_degree(250, 2);
+    monomial.set_degree(3, 1);
+    assert(monomial.get_powers().size() == 2 && monomial.get_degree() == 3 && monomial.container_size() == 251);
+    monomial.set_degree(250, 0);
+    assert(monomial == SparseMonomial("d"));
+
+    // the same results as Monomial on monomials with many variables and a few nonzero degrees
+    std::vector<Monomial> dense;
+    for (size_t i = 0; i < 40; ++i) {
+        Monomial m;
+        for (size_t j = 0; j < 3; ++j) {
+            m.set_degree((i * 37 + j * 101) % (30 + i % 7 * 20), (i + j) % 3);
+        }
+        dense.push_back(m);
+    }
+    for (const auto& a : dense) {
+        SparseMonomial sparse_a(a);
+        assert(sparse_a.to_monomial() == a);
+        assert(sparse_a.get_degree() == a.get_degree());
+        std::stringstream dense_text, sparse_text;
+        dense_text << a;
+        sparse_text << sparse_a;
+        assert(dense_text.str() == sparse_text.str());
+        for (const auto& b : dense) {
+            SparseMonomial sparse_b(b);
+            assert((sparse_a * sparse_b).to_monomial() == a * b);
+            assert((sparse_a / sparse_b).to_monomial() == a / b);
+            assert(sparse_a.is_divisible_by(sparse_b) == a.is_divisible_by(b));
+            assert(Algorithm::get_LCM(sparse_a, sparse_b).to_monomial() == Algorithm::get_LCM(a, b));
+            assert(LexOrder::cmp(sparse_a, sparse_b) == LexOrder::cmp(a, b));
+            assert(RevLexOrder::cmp(sparse_a, sparse_b) == RevLexOrder::cmp(a, b));
+            assert(DegRevLex::cmp(sparse_a, sparse_b) == DegRevLex::cmp(a, b));
+            // negative degrees, as in the inverse of a monomial
+            assert(LexOrder::cmp(SparseMonomial() / sparse_a, sparse_b) == LexOrder::cmp(Monomial() / a, b));
+        }
+    }
+
+    // the same Grobner basis with both representations
+    using Value = Modular<1'000'000'007ll>;
+    using SparsePolynomial = Polynomial<Value, SparseMonomial>;
+    assert(SparsePolynomial("2a^2b+3c") * SparsePolynomial("1a-1c") == SparsePolynomial("2a^3b-2a^2bc+3ac-3c^2"));
+    auto system = BenchmarkSystems::get_katsura<Value>(3);
+    PolynomialSet<Value, SparseMonomial> F;
+    for (const auto& f : system) {
+        SparsePolynomial g;
+        for (const auto& [monomial, coefficient] : f) {
+            g.add_monomial(SparseMonomial(monomial), coefficient);
+        }
+        F.insert(std::move(g));
+    }
+    Statistics statistics;
+    Algorithm::extend_to_grobners_basis<DegRevLex>(&F, &statistics);
+    Algorithm::extend_to_grobners_basis<DegRevLex>(&system);
+    PolynomialSet<Value> converted;
+    for (const auto& f : F) {
+        Polynomial<Value> g;
+        for (const auto& [monomial, coefficient] : f) {
+            g.add_monomial(monomial.to_monomial(), coefficient);
+        }
+        converted.insert(std::move(g));
+    }
+    assert(converted == system);
+
+    std::cout << "SparseMonomial tests passed" << std::endl;
+}
+
+std::vector<Tests::TestSystem> Tests::get_degrevlex_systems() {
+    using Poly = Polynomial<Modular<1'000'000'007ll>>;
+    return {TestSystem{Poly("1a+1b^2-1c"), Poly("1ab-1c^2+1"), Poly("1bc^2-1a^2")},
+            TestSystem{Poly("1a^4+1b^2c-1"), Poly("1a^3c+1b"), Poly("1b^2-1c^2+1ab")},
+            BenchmarkSystems::get_katsura<Modular<1'000'000'007ll>>(3),
+            BenchmarkSystems::get_cyclic<Modular<1'000'000'007ll>>(4)};
+}
+
+std::vector<Tests::TestSystem> Tests::get_lex_systems() {
+    using Poly = Polynomial<Modular<1'000'000'007ll>>;
+    return {TestSystem{Poly("1a+1b^2-1c"), Poly("1ab-1c^2+1"), Poly("1bc^2-1a^2")},
+            TestSystem{Poly("1a^2-1b+1c"), Poly("1ab-1"), Poly("1b^2-1a")},
+            BenchmarkSystems::get_cyclic<Modular<1'000'000'007ll>>(3)};
+}
+
+template<class Order, class Function>
+void Tests::check_same_basis(const std::vector<TestSystem>& systems, Function function) {
+    for (const auto& system : systems) {
+        auto expected = system;
+        Algorithm::extend_to_grobners_basis<Order>(&expected);
+        auto result = system;
+        function(&result);
+        assert(result == expected);
+    }
+}
+
+void Tests::test_linear_elimination() {
+    using Lex = LexOrder;
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    using Value = Modular<1'000'000'007ll>;
+    using Poly = Polynomial<Value>;
+    using Set = PolynomialSet<Value>;
+
+    assert(LinearElimination::substitute(Poly("1a^2b+2ab+3c"), 0, Poly("1b-1c")) ==
+           Poly("1b^3-2b^2c+1bc^2+2b^2-2bc+3c"));
+
+    // a = c - b^2, then b = 2c^2 - 1
+    Set F{Poly("1a+1b^2-1c"), Poly("1b-2c^2+1"), Poly("1a^2c-1b^3+1c")};
+    auto substitutions = LinearElimination::eliminate<DegRevLex>(&F);
+    assert(substitutions.size() == 2 && F.size() == 1);
+    for (const auto& f : F) {
+        for (const auto& [monomial, coefficient] : f) {
+            assert(monomial.get_degree(0) == 0 && monomial.get_degree(1) == 0);
+        }
+    }
+    for (const auto& substitution : substitutions) {
+        for (const auto& [monomial, coefficient] : substitution.value) {
+            assert(monomial.get_degree(0) == 0 && monomial.get_degree(1) == 0);
+        }
+    }
+
+    // one variable is removed from every system but the second Lex one, where the substitution
+    // a = b^2 makes c linear too; the removed variables don't occur in the rest of the system
+    std::vector<size_t> degrevlex_counts{1, 1, 1, 1};
+    std::vector<size_t> lex_counts{1, 2, 1};
+    auto check_eliminated = [](Set F, auto order, size_t count) {
+        auto substitutions = LinearElimination::eliminate<decltype(order)>(&F);
+        assert(substitutions.size() == count);
+        for (const auto& substitution : substitutions) {
+            for (const auto& f : F) {
+                for (const auto& [monomial, coefficient] : f) {
+                    assert(monomial.get_degree(substitution.variable) == 0);
+                }
+            }
+        }
+    };
+    auto degrevlex_systems = get_degrevlex_systems();
+    for (size_t i = 0; i < degrevlex_systems.size(); ++i) {
+        check_eliminated(degrevlex_systems[i], DegRevLex(), degrevlex_counts[i]);
+    }
+    auto lex_systems = get_lex_systems();
+    for (size_t i = 0; i < lex_systems.size(); ++i) {
+        check_eliminated(lex_systems[i], Lex(), lex_counts[i]);
+    }
+
+    // the same reduced basis as without the preprocessing, with and without leading variables
+    check_same_basis<DegRevLex>(degrevlex_systems, [](Set* F) {
+        LinearElimination::extend_to_grobners_basis<DegRevLex>(F);
+    });
+    check_same_basis<Lex>(lex_systems, [](Set* F) {
+        Statistics statistics;
+        LinearElimination::extend_to_grobners_basis<Lex>(F, &statistics);
+    });
+
+    std::cout << "LinearElimination tests passed" << std::endl;
+}
+
+void Tests::test_variable_order() {
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    using Value = Modular<1'000'000'007ll>;
+    using Poly = Polynomial<Value>;
+    using Set = PolynomialSet<Value>;
+
+    // e has degree 1, c and b degree 2, but c is in terms of smaller degree, a has degree 3,
+    // d doesn't occur
+    Set F{Poly("1a^3b^2+1c"), Poly("1a^2c^2-1b+1"), Poly("1bc-1a+1e")};
+    auto permutation = VariableOrder::get_brown_permutation(F);
+    assert((permutation == std::vector<size_t>{3, 2, 1, 4, 0}));
+    assert((VariableOrder::get_inverse(permutation) == std::vector<size_t>{4, 2, 1, 0, 3}));
+    assert(VariableOrder::permute(Poly("1a^3b^2+1c"), permutation) == Poly("1d^3c^2+1b"));
+    for (const auto& f : F) {
+        assert(VariableOrder::permute(VariableOrder::permute(f, permutation), VariableOrder::get_inverse(permutation)) == f);
+    }
+
+    // the basis of the permuted system written in the original variables
+    for (const auto& system : {F, BenchmarkSystems::get_katsura<Value>(3), BenchmarkSystems::get_cyclic<Value>(3)}) {
+        auto result = system;
+        Statistics statistics;
+        auto used = VariableOrder::extend_to_grobners_basis<DegRevLex>(&result, &statistics);
+        assert(used == VariableOrder::get_brown_permutation(system));
+        auto expected = VariableOrder::permute(system, used);
+        Algorithm::extend_to_grobners_basis<DegRevLex>(&expected);
+        assert(result == VariableOrder::permute(expected, VariableOrder::get_inverse(used)));
+    }
+
+    Set G{Poly("1a^3b^2+1c"), Poly("1a^2c^2-1b+1"), Poly("1bc-1a")};
+    VariableOrder::extend_to_grobners_basis<LexOrder>(&G);
+    for (const auto& f : Set{Poly("1a^3b^2+1c"), Poly("1a^2c^2-1b+1"), Poly("1bc-1a")}) {
+        auto g = VariableOrder::permute(f, std::vector<size_t>{2, 1, 0});
+        Algorithm::reduce_by<LexOrder>(VariableOrder::permute(G, std::vector<size_t>{2, 1, 0}), &g);
+        assert(g.is_zero());
+    }
+
+    std::cout << "VariableOrder tests passed" << std::endl;
+}
+
+void Tests::test_degree_truncation() {
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    using Value = Modular<1'000'000'007ll>;
+    using Poly = Polynomial<Value>;
+    using Set = PolynomialSet<Value>;
+
+    auto get_degree = [](const Poly& f) {
+        Monomial::DegreeType result = 0;
+        for (const auto& [monomial, coefficient] : f) {
+            result = std::max(result, monomial.get_degree());
+        }
+        return result;
+    };
+
+    // homogeneous, the reduced basis has elements of degrees 3..7
+    Set F{Poly("1a^3-1b^2c"), Poly("1ab^2-1c^3"), Poly("1a^2c-1b^3+1abc")};
+    auto G = F;
+    Algorithm::extend_to_grobners_basis<DegRevLex>(&G);
+
+    for (Monomial::DegreeType max_degree = 3; max_degree <= 8; ++max_degree) {
+        auto truncated = F;
+        auto pending = Algorithm::extend_to_grobners_basis_up_to<DegRevLex>(&truncated, max_degree);
+        for (const auto& S : pending) {
+            assert(get_degree(S) > max_degree);
+        }
+        for (auto g : G) {
+            if (get_degree(g) <= max_degree) {
+                Algorithm::reduce_by<DegRevLex>(truncated, &g);
+                assert(g.is_zero());
+            }
+        }
+
+        // one more degree, then without the bound
+        Statistics statistics;
+        Algorithm::continue_grobners_basis_up_to<DegRevLex>(&truncated, &pending, max_degree + 1, &statistics);
+        for (const auto& S : pending) {
+            assert(get_degree(S) > max_degree + 1);
+        }
+        Algorithm::continue_grobners_basis<DegRevLex>(&truncated, &pending, &statistics);
+        assert(pending.empty());
+        assert(truncated == G);
+    }
+
+    // no pending S-polynomials when the bound is not reached
+    auto H = BenchmarkSystems::get_cyclic<Value>(3);
+    auto expected = H;
+    Algorithm::extend_to_grobners_basis<DegRevLex>(&expected);
+    assert(Algorithm::extend_to_grobners_basis_up_to<DegRevLex>(&H, 100).empty());
+    assert(H == expected);
+
+    std::cout << "DegreeTruncation tests passed" << std::endl;
+}
+
+void Tests::test_homogenization() {
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    using Value = Modular<1'000'000'007ll>;
+    using Poly = Polynomial<Value>;
+    using Set = PolynomialSet<Value>;
+
+    // h is a, the variables are shifted by one
+    assert(Homogenization::homogenize(Poly("1a^2b+2c-3")) == Poly("1b^2c+2a^2d-3a^3"));
+    assert(Homogenization::homogenize(Poly("2")) == Poly("2"));
+    assert(Homogenization::dehomogenize(Poly("1b^2c+2a^2d-3a^3")) == Poly("1a^2b+2c-3"));
+    assert(Homogenization::dehomogenize(Poly("1a^2b-1b^2a")) == Poly("1a-1a^2"));
+
+    // every shared system becomes homogeneous and comes back unchanged
+    auto systems = get_degrevlex_systems();
+    for (const auto& system : systems) {
+        auto homogenized = Homogenization::homogenize(system);
+        for (const auto& f : homogenized) {
+            auto degree = Algorithm::get_leading_term<DegOrder>(f).first.get_degree();
+            for (const auto& [monomial, coefficient] : f) {
+                assert(monomial.get_degree() == degree);
+            }
+        }
+        assert(Homogenization::dehomogenize(homogenized) == system);
+    }
+
+    check_same_basis<DegRevLex>(systems, [](Set* F) {
+        Statistics statistics;
+        Homogenization::extend_to_grobners_basis(F, &statistics);
+    });
+
+    // degree by degree on the homogenized system: the S-polynomials above the bound are
+    // postponed, and they are homogeneous, so every term is above it
+    check_same_basis<DegRevLex>(systems, [](Set* F) {
+        auto homogenized = Homogenization::homogenize(*F);
+        auto pending = Algorithm::extend_to_grobners_basis_up_to<DegRevLex>(&homogenized, 2);
+        for (const auto& S : pending) {
+            for (const auto& [monomial, coefficient] : S) {
+                assert(monomial.get_degree() > 2);
+            }
+        }
+        Statistics statistics;
+        Algorithm::continue_grobners_basis<DegRevLex>(&homogenized, &pending, &statistics);
+        *F = Homogenization::dehomogenize(homogenized);
+        Algorithm::auto_reduce<DegRevLex>(F);
+    });
+
+    std::cout << "Homogenization tests passed" << std::endl;
+}
+
+void Tests::test_top_reduction() {
+    using Lex = LexOrder;
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    using Value = Modular<1'000'000'007ll>;
+    using Poly = Polynomial<Value>;
+    using Set = PolynomialSet<Value>;
+
+    Poly g("1a^2+1ab");
+    Algorithm::top_reduce_by<Lex>(Set{Poly("1a-1b")}, &g);
+    assert(g == Poly("2b^2"));
+    // only the tail is divisible, b is the leading monomial of a - b
+    g = Poly("1c^3+1b");
+    Algorithm::top_reduce_by<DegRevLex>(Set{Poly("1a-1b")}, &g);
+    assert(g == Poly("1c^3+1b"));
+    Algorithm::reduce_by<DegRevLex>(Set{Poly("1a-1b")}, &g);
+    assert(g == Poly("1c^3+1a"));
+    g = Poly("1a^2b+1ab");
+    Algorithm::top_reduce_by<DegRevLex>(Set{Poly("1ab-1")}, &g);
+    assert(g == Poly("1a+1"));
+
+    // the same basis with both policies
+    check_same_basis<DegRevLex>(get_degrevlex_systems(), [](Set* F) {
+        Statistics statistics;
+        NoPairFilter filter;
+        TopReduction<Value> reduction;
+        Algorithm::extend_to_grobners_basis<DegRevLex>(F, &statistics, &filter, &reduction);
+    });
+    check_same_basis<Lex>(get_lex_systems(), [](Set* F) {
+        NoStatistics statistics;
+        NoPairFilter filter;
+        TopReduction<Value> reduction;
+        Algorithm::extend_to_grobners_basis<Lex>(F, &statistics, &filter, &reduction);
+    });
+
+    // the tails of the S-polynomials waiting in the queue are not reduced
+    Set system{Poly("1a^4+1b^2c-1"), Poly("1a^3c+1b"), Poly("1b^2-1c^2+1ab")};
+    Statistics full_statistics;
+    auto expected = system;
+    Algorithm::extend_to_grobners_basis<Lex>(&expected, &full_statistics);
+    Statistics top_statistics;
+    auto result = system;
+    NoPairFilter filter;
+    TopReduction<Value> reduction;
+    Algorithm::extend_to_grobners_basis<Lex>(&result, &top_statistics, &filter, &reduction);
+    assert(result == expected);
+    assert(top_statistics.reduction_steps < full_statistics.reduction_steps);
+
+    std::cout << "TopReduction tests passed" << std::endl;
+}
+
+void Tests::test_quotient_ring() {
+    using Lex = LexOrder;
+    using DegRevLex = OrderSum<DegOrder, RevLexOrder>;
+
+    using Value = Modular<1'000'000'007ll>;
+    using Poly = Polynomial<Value>;
+    using Set = PolynomialSet<Value>;
+    using Ring = QuotientRing<DegRevLex, Value>;
+
+    // the origin with multiplicity 4
+    Ring ring(Set{Poly("1a^2"), Poly("1b^2")});
+    assert(ring.get_solution_count() == 4);
+    assert((ring.get_standard_monomials() == std::vector<Monomial>{Monomial(), Monomial("a"), Monomial("b"), Monomial("ab")}));
+    // a * 1 = a, a * a = 0, a * b = ab, a * ab = 0
+    auto matrix = ring.get_multiplication_matrix(0);
+    assert(matrix.size() == 4);
+    assert((matrix[0] == Ring::Column{{1, Value(1)}} && matrix[1].empty() &&
+            matrix[2] == Ring::Column{{3, Value(1)}} && matrix[3].empty()));
+    assert(ring.get_normal_form(Monomial("a^3b")) == Poly());
+
+    assert(!Ring::is_zero_dimensional(Set{Poly("1a^2-1b")}));
+    assert(!Ring::is_zero_dimensional(Set{Poly("1a^2")}, 2));
+    bool thrown = false;
+    try {
+        Ring(Set{Poly("1ab")});
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(Ring(Set{Poly("1")}).get_solution_count() == 0);
+
+    // 2^n solutions of katsura(n), 3! of cyclic(3)
+    for (const auto& [system, count] : {std::make_pair(BenchmarkSystems::get_katsura<Value>(3), size_t(8)),
+                                        std::make_pair(BenchmarkSystems::get_cyclic<Value>(3), size_t(6))}) {
+        auto basis = system;
+        Algorithm::extend_to_grobners_basis<DegRevLex>(&basis);
+        Ring quotient(basis);
+        assert(quotient.get_solution_count() == count);
+
+        // the cached normal forms agree with the reduction, the matrices commute
+        const auto& monomials = quotient.get_standard_monomials();
+        std::vector<std::vector<std::vector<Value>>> dense;
+        for (size_t i = 0; i < quotient.get_variable_count(); ++i) {
+            Monomial x;
+            x.set_degree(i, 1);
+            for (const auto& monomial : monomials) {
+                assert(quotient.get_normal_form(monomial * x) == quotient.get_normal_form(Poly(monomial * x)));
+            }
+            dense.emplace_back(count, std::vector<Value>(count, Value(0)));
+            auto matrix = quotient.get_multiplication_matrix(i);
+            for (size_t j = 0; j < count; ++j) {
+                for (const auto& [row, coefficient] : matrix[j]) {
+                    dense.back()[row][j] = coefficient;
+                }
+            }
+        }
+        auto multiply = [count](const auto& first, const auto& second) {
+            std::vector<std::vector<Value>> result(count, std::vector<Value>(count, Value(0)));
+            for (size_t i = 0; i < count; ++i) {
+                for (size_t k = 0; k < count; ++k) {
+                    for (size_t j = 0; j < count; ++j) {
+                        result[i][j] += first[i][k] * second[k][j];
+                    }
+                }
+            }
+            return result;
+        };
+        for (size_t i = 0; i < dense.size(); ++i) {
+            for (size_t j = 0; j < i; ++j) {
+                assert(multiply(dense[i], dense[j]) == multiply(dense[j], dense[i]));
+            }
+        }
+    }
+
+    // the same count from the lex basis
+    auto lex_basis = BenchmarkSystems::get_cyclic<Value>(3);
+    Algorithm::extend_to_grobners_basis<Lex>(&lex_basis);
+    assert((QuotientRing<Lex, Value>(lex_basis).get_solution_count() == 6));
+
+    std::cout << "QuotientRing tests passed" << std::endl;
+}
 
 
 void Tests::test_rational_polynomial() {
@@ -347,6 +1924,27 @@ void Tests::test_z_p_polynomial() {
 
     using Poly2 = Polynomial<Modular<2>>;
     assert(Poly2("2b+2a+28g") == Poly2());
+
+    // heap product against term by term multiplication, including cancellations and negative degrees
+    Poly f("3a^2b+5c^-1+7ab^3c+1");
+    Poly g("2a+16b^2c^2+4abc+9c^-1+1");
+    Poly expected;
+    for (const auto& [f_monomial, f_coefficient] : f) {
+        for (const auto& [g_monomial, g_coefficient] : g) {
+            expected.add_monomial(f_monomial * g_monomial, f_coefficient * g_coefficient);
+        }
+    }
+    assert(f * g == expected);
+    assert(g * f == expected);
+    assert((Poly("1a+1b") * Poly("1a+16b")) == Poly("1a^2+16b^2"));
+    assert(f * Poly() == Poly());
+    assert(f * Poly(Value(2)) == f * Value(2));
+
+    Poly shifted = f;
+    shifted *= Monomial("a^-2bc");
+    assert(shifted == Poly("3b^2c+5a^-2b+7a^-1b^4c^2+1a^-2bc"));
+    shifted /= Monomial("a^-2bc");
+    assert(shifted == f);
 }
 
 }  // grobner
@@ -0,0 +1,465 @@
+#ifndef GROBNER_TRACE_REPLAY_H_
+#define GROBNER_TRACE_REPLAY_H_
+
+#include <cassert>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "algorithm.h"
+#include "hashes.h"
+#include "monomial.h"
+#include "pair_filter.h"
+#include "polynomial.h"
+#include "polynomial_basis.h"
+#include "polynomial_set.h"
+#include "statistics.h"
+
+namespace grobner {
+
+// Straight-line program recorded by TraceReplayAlgorithm::learn: the S-polynomials and every
+// reduction step, in the order they were made. Each step computes one polynomial (a register,
+// numbered by the step index) from inputs and earlier registers. Registers are monic.
+struct GrobnerTrace {
+    // what a polynomial looks like without its coefficients, used to detect a failed replay
+    struct Support {
+        Monomial leading_monomial;
+        size_t term_count = 0;
+        // sum of the mixed hashes of all monomials (see TraceReplayAlgorithm::mix)
+        size_t hash = 0;
+
+        friend bool operator == (const Support& first, const Support& second) {
+            return first.term_count == second.term_count && first.hash == second.hash &&
+                   first.leading_monomial == second.leading_monomial;
+        }
+        friend bool operator != (const Support& first, const Support& second) {
+            return !(first == second);
+        }
+    };
+
+    enum class StepType {
+        // input number first
+        kInput,
+        // S-polynomial of registers first and second
+        kS,
+        // register first, reduced further
+        kCopy
+    };
+
+    struct Step {
+        StepType type = StepType::kInput;
+        size_t first = 0;
+        size_t second = 0;
+        // (reducer register, monomial whose term is eliminated by it)
+        std::vector<std::pair<size_t, Monomial>> reductions;
+        // of the result, which is never zero
+        Support result;
+    };
+
+    // nonzero inputs in the order of TraceReplayAlgorithm::get_sorted_inputs
+    std::vector<Support> inputs;
+    std::vector<Step> steps;
+    // S-polynomials and reductions whose result was zero, they use registers of steps but don't
+    // add registers; Step::result is not used
+    std::vector<Step> zero_steps;
+    // registers that form the reduced basis
+    std::vector<size_t> outputs;
+};
+
+// Batch mode for systems that share monomial supports and differ only in coefficients.
+// learn runs Algorithm's main loop once with TraceRecordingReduction and records a GrobnerTrace,
+// replay repeats only its arithmetic: no pair selection, no hashing, no divisor search.
+// Every step of the replay checks that the polynomial it computes has the recorded support,
+// so a system of a different shape is detected and replay fails. The zero steps are replayed
+// too and must give zero again: they are the reductions that prove the result to be a Grobner
+// basis, so a system whose pairs don't reduce to zero where they did in learn fails as well.
+class TraceReplayAlgorithm {
+  public:
+    // F becomes its reduced Grobner basis, as with Algorithm::extend_to_grobners_basis
+    template<class Order, class ValueType>
+    static GrobnerTrace learn(PolynomialSet<ValueType>* F);
+    template<class Order, class ValueType, class Monitor>
+    static GrobnerTrace learn(PolynomialSet<ValueType>* F, Monitor* monitor);
+
+    // returns false and leaves F unchanged if F doesn't follow the trace
+    template<class Order, class ValueType>
+    static bool replay(const GrobnerTrace& trace, PolynomialSet<ValueType>* F);
+    template<class Order, class ValueType, class Monitor>
+    static bool replay(const GrobnerTrace& trace, PolynomialSet<ValueType>* F, Monitor* monitor);
+
+    // replay, falls back to Algorithm::extend_to_grobners_basis if it fails; returns true if replayed
+    template<class Order, class ValueType>
+    static bool extend_to_grobners_basis(const GrobnerTrace& trace, PolynomialSet<ValueType>* F);
+    template<class Order, class ValueType, class Monitor>
+    static bool extend_to_grobners_basis(const GrobnerTrace& trace, PolynomialSet<ValueType>* F, Monitor* monitor);
+
+    template<class Order, class ValueType>
+    static GrobnerTrace::Support get_support(const Polynomial<ValueType>& f);
+
+    // nonzero polynomials of F sorted by support, so that the order doesn't depend on coefficients
+    template<class Order, class ValueType>
+    static std::vector<Polynomial<ValueType>> get_sorted_inputs(const PolynomialSet<ValueType>& F);
+
+  private:
+    // splitmix64 finalizer; hash<Monomial> is linear in the degrees, so plain sums of hashes
+    // collide for different supports, e.g. a^3 + ab + 1 and a^3 + a + b
+    inline static uint64_t mix(uint64_t value);
+
+    // the polynomial of step before its normalization, false if a reduction doesn't apply;
+    // the input of a kInput step is moved out of inputs
+    template<class ValueType, class Monitor>
+    static bool compute_step(const GrobnerTrace& trace, const GrobnerTrace::Step& step,
+                             std::vector<Polynomial<ValueType>>* inputs, const std::vector<Polynomial<ValueType>>& registers,
+                             Polynomial<ValueType>* g, Monitor* monitor);
+};
+
+// Reduction policy (see FullReduction) with which TraceReplayAlgorithm::learn runs Algorithm's
+// main loop. Every polynomial the loop gets from the policy is a register of the trace, and
+// registers are found by their values: S-polynomials and the results of reductions are made
+// monic, and a reduction eliminates the largest reducible term first, using the first element
+// of the basis whose leading monomial divides it. Zero results go to GrobnerTrace::zero_steps.
+template<class ValueType>
+class TraceRecordingReduction {
+  public:
+    explicit TraceRecordingReduction(GrobnerTrace* trace);
+
+    // records input number index, returns its value as a register
+    template<class Order>
+    Polynomial<ValueType> add_input(size_t index, Polynomial<ValueType> f);
+    // f is a value of a register
+    size_t find_register(const Polynomial<ValueType>& f) const;
+
+    template<class Order>
+    void set_basis(const PolynomialSet<ValueType>& F);
+
+    template<class Order, class Monitor>
+    Polynomial<ValueType> get_S(const Polynomial<ValueType>& f, const Polynomial<ValueType>& g, Monitor* monitor);
+
+    template<class Order, class Monitor>
+    void reduce(const PolynomialSet<ValueType>& F, Polynomial<ValueType>* g, Monitor* monitor);
+
+    template<class Order>
+    Monomial normalize(Polynomial<ValueType>* f);
+
+    template<class Order, class Monitor>
+    void reduce_fully(const PolynomialBasis<ValueType>& F, Polynomial<ValueType>* g, Monitor* monitor);
+
+  private:
+    // reduces the register g by registers ids and records the result
+    template<class Order, class Monitor>
+    void reduce_by_registers(const std::vector<size_t>& ids, Polynomial<ValueType>* g, Monitor* monitor);
+
+    // makes g monic and appends it as a new register with its step, or as a zero step
+    template<class Order>
+    void add_register(Polynomial<ValueType>* g, GrobnerTrace::Step&& step);
+
+    GrobnerTrace* trace_;
+    std::vector<Polynomial<ValueType>> registers_;
+    // hash of the value -> register
+    std::unordered_multimap<size_t, size_t> registers_by_hash_;
+    // registers of the basis of the last set_basis
+    std::vector<size_t> basis_;
+};
+
+
+template<class Order, class ValueType>
+GrobnerTrace TraceReplayAlgorithm::learn(PolynomialSet<ValueType>* F) {
+    NoStatistics statistics;
+    return learn<Order>(F, &statistics);
+}
+
+template<class Order, class ValueType, class Monitor>
+GrobnerTrace TraceReplayAlgorithm::learn(PolynomialSet<ValueType>* F, Monitor* monitor) {
+    GrobnerTrace trace;
+    TraceRecordingReduction<ValueType> reduction(&trace);
+    auto inputs = get_sorted_inputs<Order>(*F);
+    PolynomialSet<ValueType> G;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        trace.inputs.push_back(get_support<Order>(inputs[i]));
+        G.insert(reduction.template add_input<Order>(i, std::move(inputs[i])));
+    }
+
+    NoPairFilter filter;
+    Algorithm::extend_to_grobners_basis<Order>(&G, monitor, &filter, &reduction);
+    for (const auto& g : G) {
+        trace.outputs.push_back(reduction.find_register(g));
+    }
+    *F = std::move(G);
+    return trace;
+}
+
+template<class Order, class ValueType>
+bool TraceReplayAlgorithm::replay(const GrobnerTrace& trace, PolynomialSet<ValueType>* F) {
+    NoStatistics statistics;
+    return replay<Order>(trace, F, &statistics);
+}
+
+template<class Order, class ValueType, class Monitor>
+bool TraceReplayAlgorithm::replay(const GrobnerTrace& trace, PolynomialSet<ValueType>* F, Monitor* monitor) {
+    auto inputs = get_sorted_inputs<Order>(*F);
+    if (inputs.size() != trace.inputs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (get_support<Order>(inputs[i]) != trace.inputs[i]) {
+            return false;
+        }
+    }
+
+    std::vector<Polynomial<ValueType>> registers;
+    registers.reserve(trace.steps.size());
+    for (const auto& step : trace.steps) {
+        Polynomial<ValueType> g;
+        if (!compute_step(trace, step, &inputs, registers, &g, monitor) || g.is_zero() ||
+                get_support<Order>(g) != step.result) {
+            return false;
+        }
+        g /= g.get_coefficient(step.result.leading_monomial);
+        registers.push_back(std::move(g));
+    }
+    for (const auto& step : trace.zero_steps) {
+        Polynomial<ValueType> g;
+        if (!compute_step(trace, step, &inputs, registers, &g, monitor) || !g.is_zero()) {
+            return false;
+        }
+    }
+
+    F->clear();
+    for (auto id : trace.outputs) {
+        F->insert(std::move(registers[id]));
+    }
+    return true;
+}
+
+template<class Order, class ValueType>
+bool TraceReplayAlgorithm::extend_to_grobners_basis(const GrobnerTrace& trace, PolynomialSet<ValueType>* F) {
+    NoStatistics statistics;
+    return extend_to_grobners_basis<Order>(trace, F, &statistics);
+}
+
+template<class Order, class ValueType, class Monitor>
+bool TraceReplayAlgorithm::extend_to_grobners_basis(const GrobnerTrace& trace, PolynomialSet<ValueType>* F,
+                                                    Monitor* monitor) {
+    if (replay<Order>(trace, F, monitor)) {
+        return true;
+    }
+    Algorithm::extend_to_grobners_basis<Order>(F, monitor);
+    return false;
+}
+
+template<class Order, class ValueType>
+GrobnerTrace::Support TraceReplayAlgorithm::get_support(const Polynomial<ValueType>& f) {
+    GrobnerTrace::Support support;
+    if (f.is_zero()) {
+        return support;
+    }
+    support.leading_monomial = Algorithm::get_leading_term<Order>(f).first;
+    support.term_count = f.size();
+    for (const auto& [monomial, coefficient] : f) {
+        support.hash += mix(hash<Monomial>()(monomial));
+    }
+    return support;
+}
+
+template<class Order, class ValueType>
+std::vector<Polynomial<ValueType>> TraceReplayAlgorithm::get_sorted_inputs(const PolynomialSet<ValueType>& F) {
+    std::vector<std::pair<GrobnerTrace::Support, Polynomial<ValueType>>> sorted;
+    for (const auto& f : F) {
+        if (!f.is_zero()) {
+            sorted.emplace_back(get_support<Order>(f), f);
+        }
+    }
+    // polynomials with equal supports are interchangeable, their order doesn't matter
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        if (a.first.leading_monomial != b.first.leading_monomial) {
+            return Order()(a.first.leading_monomial, b.first.leading_monomial);
+        }
+        return std::make_pair(a.first.term_count, a.first.hash) < std::make_pair(b.first.term_count, b.first.hash);
+    });
+    std::vector<Polynomial<ValueType>> result;
+    result.reserve(sorted.size());
+    for (auto& [support, f] : sorted) {
+        result.push_back(std::move(f));
+    }
+    return result;
+}
+
+
+uint64_t TraceReplayAlgorithm::mix(uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+}
+
+template<class ValueType, class Monitor>
+bool TraceReplayAlgorithm::compute_step(const GrobnerTrace& trace, const GrobnerTrace::Step& step,
+                                        std::vector<Polynomial<ValueType>>* inputs,
+                                        const std::vector<Polynomial<ValueType>>& registers,
+                                        Polynomial<ValueType>* g, Monitor* monitor) {
+    if (step.type == GrobnerTrace::StepType::kInput) {
+        *g = std::move((*inputs)[step.first]);
+    } else if (step.type == GrobnerTrace::StepType::kS) {
+        monitor->on_phase_started(Phase::kGetS);
+        const auto& first_lead = trace.steps[step.first].result.leading_monomial;
+        const auto& second_lead = trace.steps[step.second].result.leading_monomial;
+        auto lcm = Algorithm::get_LCM(first_lead, second_lead);
+        *g = registers[step.first] * (lcm / first_lead) - registers[step.second] * (lcm / second_lead);
+        monitor->on_phase_finished(Phase::kGetS);
+    } else {
+        *g = registers[step.first];
+    }
+
+    monitor->on_phase_started(Phase::kReduce);
+    for (const auto& [reducer, monomial] : step.reductions) {
+        auto coefficient = g->get_coefficient(monomial);
+        if (coefficient == ValueType(0)) {
+            monitor->on_phase_finished(Phase::kReduce);
+            return false;
+        }
+        *g -= registers[reducer] * (monomial / trace.steps[reducer].result.leading_monomial) * coefficient;
+        monitor->on_reduction_step();
+    }
+    monitor->on_phase_finished(Phase::kReduce);
+    return true;
+}
+
+
+template<class ValueType>
+TraceRecordingReduction<ValueType>::TraceRecordingReduction(GrobnerTrace* trace) :
+    trace_(trace) {
+}
+
+template<class ValueType>
+template<class Order>
+Polynomial<ValueType> TraceRecordingReduction<ValueType>::add_input(size_t index, Polynomial<ValueType> f) {
+    GrobnerTrace::Step step;
+    step.type = GrobnerTrace::StepType::kInput;
+    step.first = index;
+    add_register<Order>(&f, std::move(step));
+    return f;
+}
+
+template<class ValueType>
+size_t TraceRecordingReduction<ValueType>::find_register(const Polynomial<ValueType>& f) const {
+    auto [begin, end] = registers_by_hash_.equal_range(hash<Polynomial<ValueType>>()(f));
+    for (auto it = begin; it != end; ++it) {
+        if (registers_[it->second] == f) {
+            return it->second;
+        }
+    }
+    assert(false);
+    return 0;
+}
+
+template<class ValueType>
+template<class Order>
+void TraceRecordingReduction<ValueType>::set_basis(const PolynomialSet<ValueType>& F) {
+    basis_.clear();
+    for (const auto& f : F) {
+        basis_.push_back(find_register(f));
+    }
+}
+
+template<class ValueType>
+template<class Order, class Monitor>
+Polynomial<ValueType> TraceRecordingReduction<ValueType>::get_S(const Polynomial<ValueType>& f,
+                                                                const Polynomial<ValueType>& g, Monitor* monitor) {
+    GrobnerTrace::Step step;
+    step.type = GrobnerTrace::StepType::kS;
+    step.first = find_register(f);
+    step.second = find_register(g);
+    // registers are monic, so this is the difference computed by the replay
+    auto S = Algorithm::get_S<Order>(f, g, monitor);
+    add_register<Order>(&S, std::move(step));
+    return S;
+}
+
+template<class ValueType>
+template<class Order, class Monitor>
+void TraceRecordingReduction<ValueType>::reduce(const PolynomialSet<ValueType>&, Polynomial<ValueType>* g,
+                                                Monitor* monitor) {
+    reduce_by_registers<Order>(basis_, g, monitor);
+}
+
+template<class ValueType>
+template<class Order>
+Monomial TraceRecordingReduction<ValueType>::normalize(Polynomial<ValueType>* f) {
+    // registers are monic already
+    return Algorithm::get_leading_term<Order>(*f).first;
+}
+
+template<class ValueType>
+template<class Order, class Monitor>
+void TraceRecordingReduction<ValueType>::reduce_fully(const PolynomialBasis<ValueType>& F,
+                                                      Polynomial<ValueType>* g, Monitor* monitor) {
+    std::vector<size_t> ids;
+    ids.reserve(F.size());
+    for (const auto& f : F) {
+        ids.push_back(find_register(f));
+    }
+    reduce_by_registers<Order>(ids, g, monitor);
+}
+
+template<class ValueType>
+template<class Order, class Monitor>
+void TraceRecordingReduction<ValueType>::reduce_by_registers(const std::vector<size_t>& ids, Polynomial<ValueType>* g,
+                                                             Monitor* monitor) {
+    if (g->is_zero()) {
+        return;
+    }
+    GrobnerTrace::Step step;
+    step.type = GrobnerTrace::StepType::kCopy;
+    step.first = find_register(*g);
+
+    monitor->on_phase_started(Phase::kReduce);
+    const auto& steps = trace_->steps;
+    while (true) {
+        const Monomial* best_monomial = nullptr;
+        size_t best_reducer = 0;
+        for (const auto& [monomial, coefficient] : *g) {
+            if (best_monomial != nullptr && !Order()(*best_monomial, monomial)) {
+                continue;
+            }
+            for (auto id : ids) {
+                if (monomial.is_divisible_by(steps[id].result.leading_monomial)) {
+                    best_monomial = &monomial;
+                    best_reducer = id;
+                    break;
+                }
+            }
+        }
+        if (best_monomial == nullptr) {
+            break;
+        }
+        auto monomial = *best_monomial;
+        auto coefficient = g->get_coefficient(monomial);
+        *g -= registers_[best_reducer] * (monomial / steps[best_reducer].result.leading_monomial) * coefficient;
+        step.reductions.emplace_back(best_reducer, std::move(monomial));
+        monitor->on_reduction_step();
+    }
+    monitor->on_phase_finished(Phase::kReduce);
+
+    // unchanged g is still the same register
+    if (!step.reductions.empty()) {
+        add_register<Order>(g, std::move(step));
+    }
+}
+
+template<class ValueType>
+template<class Order>
+void TraceRecordingReduction<ValueType>::add_register(Polynomial<ValueType>* g, GrobnerTrace::Step&& step) {
+    if (g->is_zero()) {
+        trace_->zero_steps.push_back(std::move(step));
+        return;
+    }
+    step.result = TraceReplayAlgorithm::get_support<Order>(*g);
+    *g /= g->get_coefficient(step.result.leading_monomial);
+    registers_by_hash_.emplace(hash<Polynomial<ValueType>>()(*g), registers_.size());
+    registers_.push_back(*g);
+    trace_->steps.push_back(std::move(step));
+}
+
+}  // grobner
+
+#endif  // GROBNER_TRACE_REPLAY_H_
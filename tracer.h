@@ -0,0 +1,184 @@
+#ifndef GROBNER_TRACER_H_
+#define GROBNER_TRACER_H_
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "declarations.h"
+#include "statistics.h"
+
+namespace grobner {
+
+// Monitor that records timestamped events of a run, can be written in chrome trace-event
+// format (chrome://tracing, Perfetto). Each thread gets its own track.
+class Tracer : public NoStatistics {
+  public:
+    enum class EventType : char {
+        kBegin = 'B',
+        kEnd = 'E',
+        kInstant = 'i',
+        kCounter = 'C'
+    };
+
+    struct Event {
+        EventType type;
+        // static string, not owned
+        const char* name;
+        // microseconds since construction of the tracer
+        double timestamp;
+        int thread;
+        // meaning depends on the event, e.g. number of terms; negative if absent
+        long long value;
+    };
+
+    // capacity == 0 means unbounded, otherwise only the last capacity events are kept
+    explicit Tracer(size_t capacity = 0);
+
+    template<class ValueType>
+    void on_pair_selected(const Polynomial<ValueType>& f);
+    template<class ValueType>
+    void on_reduction_started(const Polynomial<ValueType>& f);
+    template<class ValueType>
+    void on_reduction_finished(const Polynomial<ValueType>& f);
+    template<class ValueType>
+    void on_basis_inserted(const Polynomial<ValueType>& f);
+    template<class ValueType>
+    void on_basis_changed(const PolynomialSet<ValueType>& F);
+    void on_phase_started(Phase phase);
+    void on_phase_finished(Phase phase);
+
+    void record(EventType type, const char* name, long long value = -1);
+
+    // events in chronological order
+    std::vector<Event> get_events() const;
+    size_t get_dropped_count() const;
+
+    void write_chrome_json(std::ostream& out) const;
+
+  private:
+    static const char* get_phase_name(Phase phase);
+    static int get_thread_index();
+
+    std::chrono::steady_clock::time_point start_;
+    size_t capacity_;
+    // ring buffer if capacity_ != 0, next_ is the position of the oldest event when it is full
+    std::vector<Event> events_;
+    size_t next_ = 0;
+    size_t dropped_ = 0;
+    mutable std::mutex mutex_;
+};
+
+
+inline Tracer::Tracer(size_t capacity) : start_(std::chrono::steady_clock::now()), capacity_(capacity) {
+    events_.reserve(capacity_);
+}
+
+template<class ValueType>
+void Tracer::on_pair_selected(const Polynomial<ValueType>& f) {
+    record(EventType::kInstant, "select_pair", f.size());
+}
+
+template<class ValueType>
+void Tracer::on_reduction_started(const Polynomial<ValueType>& f) {
+    record(EventType::kBegin, "reduce_s", f.size());
+}
+
+template<class ValueType>
+void Tracer::on_reduction_finished(const Polynomial<ValueType>& f) {
+    record(EventType::kEnd, "reduce_s", f.size());
+}
+
+template<class ValueType>
+void Tracer::on_basis_inserted(const Polynomial<ValueType>& f) {
+    record(EventType::kInstant, "insert", f.size());
+}
+
+template<class ValueType>
+void Tracer::on_basis_changed(const PolynomialSet<ValueType>& F) {
+    record(EventType::kCounter, "basis_size", F.size());
+}
+
+inline void Tracer::on_phase_started(Phase phase) {
+    record(EventType::kBegin, get_phase_name(phase));
+}
+
+inline void Tracer::on_phase_finished(Phase phase) {
+    record(EventType::kEnd, get_phase_name(phase));
+}
+
+inline void Tracer::record(EventType type, const char* name, long long value) {
+    Event event;
+    event.type = type;
+    event.name = name;
+    event.timestamp = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_).count();
+    event.thread = get_thread_index();
+    event.value = value;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (capacity_ == 0 || events_.size() < capacity_) {
+        events_.push_back(event);
+    } else {
+        events_[next_] = event;
+        next_ = (next_ + 1) % capacity_;
+        ++dropped_;
+    }
+}
+
+inline std::vector<Tracer::Event> Tracer::get_events() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Event> result(events_.begin() + next_, events_.end());
+    result.insert(result.end(), events_.begin(), events_.begin() + next_);
+    return result;
+}
+
+inline size_t Tracer::get_dropped_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+}
+
+inline void Tracer::write_chrome_json(std::ostream& out) const {
+    auto events = get_events();
+    out << "{\"traceEvents\": [\n";
+    for (size_t i = 0; i < events.size(); ++i) {
+        const auto& event = events[i];
+        out << "  {\"name\": \"" << event.name << "\", \"ph\": \"" << char(event.type) << "\", "
+            << "\"ts\": " << std::fixed << event.timestamp << std::defaultfloat << ", "
+            << "\"pid\": 1, \"tid\": " << event.thread;
+        if (event.type == EventType::kInstant) {
+            out << ", \"s\": \"t\"";
+        }
+        if (event.value >= 0) {
+            out << ", \"args\": {\"" << (event.type == EventType::kCounter ? "size" : "terms") << "\": "
+                << event.value << "}";
+        }
+        out << "}" << (i + 1 == events.size() ? "" : ",") << "\n";
+    }
+    out << "], \"displayTimeUnit\": \"ms\"}\n";
+}
+
+inline const char* Tracer::get_phase_name(Phase phase) {
+    switch (phase) {
+        case Phase::kGetS:
+            return "get_S";
+        case Phase::kReduce:
+            return "reduce_by";
+        case Phase::kAutoReduce:
+            return "auto_reduce";
+        default:
+            return "unknown";
+    }
+}
+
+inline int Tracer::get_thread_index() {
+    static std::atomic<int> thread_count{0};
+    thread_local int index = thread_count++;
+    return index;
+}
+
+}  // grobner
+
+#endif  // GROBNER_TRACER_H_
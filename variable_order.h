@@ -0,0 +1,129 @@
+#ifndef GROBNER_VARIABLE_ORDER_H_
+#define GROBNER_VARIABLE_ORDER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#include "algorithm.h"
+#include "monomial.h"
+#include "polynomial.h"
+#include "polynomial_set.h"
+#include "statistics.h"
+
+namespace grobner {
+
+// Chooses the order of the variables before the computation. Monomial orders compare variables
+// by their positions, so a permutation of the variables changes the order, and with it the time
+// of the computation and the basis. Brown's heuristic puts first (the position of a in a..z, the
+// greatest variable in LexOrder) the variables of the smallest degree, then of the smallest
+// total degree of the terms containing them, then occurring in the fewest terms.
+class VariableOrder {
+  public:
+    // permutation[i] is the new position of variable i, variables that don't occur go last
+    template<class ValueType, class MonomialType = Monomial>
+    static std::vector<size_t> get_brown_permutation(const PolynomialSet<ValueType, MonomialType>& F);
+
+    // variable i is replaced by variable permutation[i]
+    template<class ValueType, class MonomialType = Monomial>
+    static Polynomial<ValueType, MonomialType> permute(const Polynomial<ValueType, MonomialType>& f,
+                                                       const std::vector<size_t>& permutation);
+    template<class ValueType, class MonomialType = Monomial>
+    static PolynomialSet<ValueType, MonomialType> permute(const PolynomialSet<ValueType, MonomialType>& F,
+                                                          const std::vector<size_t>& permutation);
+
+    static std::vector<size_t> get_inverse(const std::vector<size_t>& permutation);
+
+    // F is replaced by the reduced Grobner basis for Order applied to the variables permuted by
+    // get_brown_permutation, written in the original variables; returns the permutation
+    template<class Order, class ValueType, class MonomialType = Monomial>
+    static std::vector<size_t> extend_to_grobners_basis(PolynomialSet<ValueType, MonomialType>* F);
+    template<class Order, class ValueType, class Monitor, class MonomialType = Monomial>
+    static std::vector<size_t> extend_to_grobners_basis(PolynomialSet<ValueType, MonomialType>* F, Monitor* monitor);
+};
+
+
+template<class ValueType, class MonomialType>
+std::vector<size_t> VariableOrder::get_brown_permutation(const PolynomialSet<ValueType, MonomialType>& F) {
+    // (doesn't occur, degree, max total degree of the terms with the variable, number of terms)
+    using Key = std::tuple<bool, typename MonomialType::DegreeType, typename MonomialType::DegreeType, size_t>;
+    std::vector<Key> keys;
+    for (const auto& f : F) {
+        for (const auto& [monomial, coefficient] : f) {
+            if (keys.size() < monomial.container_size()) {
+                keys.resize(monomial.container_size(), Key(true, 0, 0, 0));
+            }
+            for (size_t i = 0; i < monomial.container_size(); ++i) {
+                auto degree = monomial.get_degree(i);
+                if (degree == 0) {
+                    continue;
+                }
+                auto& [is_absent, max_degree, max_total_degree, terms] = keys[i];
+                is_absent = false;
+                max_degree = std::max(max_degree, degree);
+                max_total_degree = std::max(max_total_degree, monomial.get_degree());
+                ++terms;
+            }
+        }
+    }
+
+    std::vector<size_t> variables(keys.size());
+    std::iota(variables.begin(), variables.end(), 0);
+    std::stable_sort(variables.begin(), variables.end(), [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+    return get_inverse(variables);
+}
+
+template<class ValueType, class MonomialType>
+Polynomial<ValueType, MonomialType> VariableOrder::permute(const Polynomial<ValueType, MonomialType>& f,
+                                                           const std::vector<size_t>& permutation) {
+    Polynomial<ValueType, MonomialType> result;
+    for (const auto& [monomial, coefficient] : f) {
+        MonomialType permuted;
+        for (size_t i = 0; i < monomial.container_size(); ++i) {
+            if (monomial.get_degree(i) != 0) {
+                permuted.set_degree(i < permutation.size() ? permutation[i] : i, monomial.get_degree(i));
+            }
+        }
+        result.add_monomial(permuted, coefficient);
+    }
+    return result;
+}
+
+template<class ValueType, class MonomialType>
+PolynomialSet<ValueType, MonomialType> VariableOrder::permute(const PolynomialSet<ValueType, MonomialType>& F,
+                                                              const std::vector<size_t>& permutation) {
+    PolynomialSet<ValueType, MonomialType> result;
+    for (const auto& f : F) {
+        result.insert(permute(f, permutation));
+    }
+    return result;
+}
+
+inline std::vector<size_t> VariableOrder::get_inverse(const std::vector<size_t>& permutation) {
+    std::vector<size_t> inverse(permutation.size());
+    for (size_t i = 0; i < permutation.size(); ++i) {
+        inverse[permutation[i]] = i;
+    }
+    return inverse;
+}
+
+template<class Order, class ValueType, class MonomialType>
+std::vector<size_t> VariableOrder::extend_to_grobners_basis(PolynomialSet<ValueType, MonomialType>* F) {
+    NoStatistics statistics;
+    return extend_to_grobners_basis<Order>(F, &statistics);
+}
+
+template<class Order, class ValueType, class Monitor, class MonomialType>
+std::vector<size_t> VariableOrder::extend_to_grobners_basis(PolynomialSet<ValueType, MonomialType>* F, Monitor* monitor) {
+    auto permutation = get_brown_permutation(*F);
+    auto permuted = permute(*F, permutation);
+    Algorithm::extend_to_grobners_basis<Order>(&permuted, monitor);
+    *F = permute(permuted, get_inverse(permutation));
+    return permutation;
+}
+
+}  // grobner
+
+#endif  // GROBNER_VARIABLE_ORDER_H_